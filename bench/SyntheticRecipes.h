@@ -0,0 +1,124 @@
+#ifndef SYNTHETIC_RECIPES_H
+#define SYNTHETIC_RECIPES_H
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem> // temp_directory_path: 데이터 파일은 저장소 밖(임시 디렉터리)에 둠
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "RecipeDatabase.h"
+
+using namespace std;
+
+/*
+ * bool writeSyntheticRecipes(const string &path, size_t count, uint32_t seed = 1): Recipe.txt 형식의 가짜 레시피 count개를 path에 씁니다.
+ * details: 제목은 "Dish <번호> <재료 이름>", 재료는 자주 쓰는 이름 12개 + "ing0" ~ "ing2999" 중에서 1~8개를 고릅니다.
+ *          같은 seed면 항상 같은 파일이 나옵니다. (벤치마크끼리 결과를 비교할 수 있도록)
+ * return 파일을 쓸 수 없으면 false
+ */
+inline bool writeSyntheticRecipes(const string &path, size_t count, uint32_t seed = 1)
+{
+    ofstream out(path, ios::binary | ios::trunc);
+    if (!out.is_open())
+        return false;
+
+    vector<string> ingredients = {"chicken breast", "soy sauce", "sugar", "flour", "egg", "heavy cream",
+                                  "garlic", "onion", "rice", "butter", "Masala paste", "tomato"};
+    for (int i = 0; i < 3000; i++)
+        ingredients.push_back("ing" + to_string(i));
+    const char *units[] = {"cup", "tbsp", "tsp", "ea", "cloves", "g", "ml", "to serve"};
+    const char *quantities[] = {"1", "0.5", "2", "0", "3", "1.5"};
+
+    mt19937 rng(seed);
+    auto pick = [&](size_t n) { return static_cast<size_t>(rng() % n); };
+    string text;
+    for (size_t i = 0; i < count; i++)
+    {
+        // 제목의 재료 이름은 단어마다 첫 글자를 대문자로 (대소문자 구분 없는 검색을 거치도록)
+        string titleWord = ingredients[pick(ingredients.size())];
+        for (size_t k = 0; k < titleWord.size(); k++)
+        {
+            if ((k == 0 || titleWord[k - 1] == ' ') && titleWord[k] >= 'a' && titleWord[k] <= 'z')
+                titleWord[k] = static_cast<char>(titleWord[k] - 'a' + 'A');
+        }
+        text += "Recipe name: Dish " + to_string(i) + " " + titleWord + "\n";
+        text += "Recipe Procedure:\n";
+        size_t steps = 1 + pick(6);
+        for (size_t s = 1; s <= steps; s++)
+            text += "Step " + to_string(s) + ": Do thing " + ingredients[pick(ingredients.size())] + " with care, then wait: " + to_string(1 + pick(60)) + " minutes.\n";
+        text += "Time: " + to_string(5 + pick(176)) + "\n";
+        text += "Ingredients: ";
+        size_t ingredientCount = 1 + pick(8);
+        for (size_t k = 0; k < ingredientCount; k++)
+        {
+            if (k > 0)
+                text += ", ";
+            text += ingredients[pick(ingredients.size())] + "|" + quantities[pick(6)] + "|" + units[pick(8)];
+        }
+        text += "\nGrade: ";
+        text += "ABC"[pick(3)];
+        text += "\n\n";
+
+        if (text.size() >= (8u << 20)) // 8MB씩 나누어 씀
+        {
+            out.write(text.data(), static_cast<streamsize>(text.size()));
+            text.clear();
+        }
+    }
+    out.write(text.data(), static_cast<streamsize>(text.size()));
+    return static_cast<bool>(out);
+}
+
+// 기본 데이터 파일 경로: 임시 디렉터리의 "<name>_<count>.txt" (레시피 수마다 다른 파일)
+inline string defaultSyntheticPath(const string &name, size_t count)
+{
+    return (filesystem::temp_directory_path() / (name + "_" + to_string(count) + ".txt")).string();
+}
+
+/*
+ * bool loadSyntheticRecipes(RecipeDatabase &db, const string &path, size_t count, double *loadSeconds = nullptr):
+ * path의 가짜 레시피를 db에 읽습니다. 파일이 없거나 레시피 수가 count와 다르면 count개로 다시 만들고 읽습니다.
+ * details: 읽은 파일과 레시피 수를 출력합니다. loadSeconds가 있으면 마지막으로 읽는 데 걸린 시간(파일 만들기 제외)을 담습니다.
+ * return 파일을 쓰거나 읽을 수 없으면 false
+ */
+inline bool loadSyntheticRecipes(RecipeDatabase &db, const string &path, size_t count, double *loadSeconds = nullptr)
+{
+    auto generate = [&]()
+    {
+        cout << "Generating " << count << " recipes into " << path << "..." << endl;
+        if (writeSyntheticRecipes(path, count))
+            return true;
+        cout << "Cannot write " << path << endl;
+        return false;
+    };
+    auto load = [&]()
+    {
+        auto start = chrono::steady_clock::now();
+        if (!db.loadFromFileParallel(path))
+        {
+            cout << "Cannot load " << path << endl;
+            return false;
+        }
+        if (loadSeconds != nullptr)
+            *loadSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        return true;
+    };
+
+    if (!ifstream(path).good() && !generate())
+        return false;
+    if (!load())
+        return false;
+    if (db.getRecipes().size() != count)
+    {
+        cout << path << " has " << db.getRecipes().size() << " recipes, not " << count << "." << endl;
+        if (!generate() || !load())
+            return false;
+    }
+    cout << "Loaded " << db.getRecipes().size() << " recipes from " << path << endl;
+    return true;
+}
+
+#endif // SYNTHETIC_RECIPES_H
@@ -0,0 +1,126 @@
+/*
+ * scan_kernels.cpp: TextScan의 스칼라 / SSE2 / AVX2 커널이 대소문자 구분 없는 부분 문자열 검색을 초당 몇 GB 처리하는지 잽니다.
+ *
+ * 빌드 (저장소 최상위에서):
+ *   g++ -std=c++17 -O2 -pthread -Isrc bench/scan_kernels.cpp -o scan_kernels
+ * 실행:
+ *   ./scan_kernels [레시피 수 = 200000] [데이터 파일 = 임시 디렉터리/bench_scan_recipes_<레시피 수>.txt]
+ *   데이터 파일이 없거나 레시피 수가 다르면 SyntheticRecipes.h로 다시 만듭니다.
+ *
+ * 검색 대상은 검색 색인이 실제로 훑는 것과 같은 모양으로, 모든 제목을 이어 붙인 문자열 + 재료 이름 어휘('\n' 구분)입니다.
+ * 각 커널은 먼저 같은 결과(일치 개수)를 내는지 확인한 뒤 needle마다 0.5초씩 잽니다.
+ * 비교용으로 "버퍼 전체를 소문자로 복사한 뒤 string::find"도 함께 잽니다. (커널 도입 전의 방식)
+ */
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "RecipeDatabase.h"
+#include "SyntheticRecipes.h"
+#include "TextScan.h"
+
+using namespace std;
+
+struct NamedKernel
+{
+    const char *name;
+    TextScan::Kernel find;
+};
+
+// 이 빌드와 이 CPU에서 실행할 수 있는 커널 목록
+static vector<NamedKernel> availableKernels()
+{
+    vector<NamedKernel> kernels = {{"scalar", TextScan::findScalar}};
+#if TEXT_SCAN_SSE2
+    kernels.push_back({"SSE2", TextScan::findSse2});
+#endif
+#if TEXT_SCAN_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        kernels.push_back({"AVX2", TextScan::findAvx2});
+#endif
+    return kernels;
+}
+
+// 0.5초 동안 buffer 전체에서 needle을 모두 찾기를 반복해 GB/s와 한 번에 찾은 개수를 돌려줍니다.
+template <typename Scan>
+static double throughput(const string &buffer, Scan scanOnce, size_t &hits)
+{
+    auto start = chrono::steady_clock::now();
+    size_t rounds = 0;
+    double elapsed = 0;
+    do
+    {
+        hits = scanOnce();
+        rounds++;
+        elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    } while (elapsed < 0.5);
+    return static_cast<double>(buffer.size()) * rounds / elapsed / 1e9;
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = argc > 1 ? stoul(argv[1]) : 200000;
+    string path = argc > 2 ? argv[2] : defaultSyntheticPath("bench_scan_recipes", count);
+
+    RecipeDatabase db;
+    db.setLazyProcedures(true);
+    if (!loadSyntheticRecipes(db, path, count) || db.getRecipes().empty())
+        return 1;
+
+    // 제목 열 + 재료 이름 어휘를 하나의 버퍼로
+    string buffer;
+    const RecipeColumns &columns = db.getColumns();
+    for (size_t row = 0; row < columns.size(); row++)
+        buffer += columns.titleAt(row);
+    const SymbolTable &names = *db.getRecipes()[0].getSymbols();
+    for (uint32_t id = 0; id < names.size(); id++)
+    {
+        buffer += names.name(id);
+        buffer += '\n';
+    }
+
+    vector<NamedKernel> kernels = availableKernels();
+    cout << "Buffer: " << buffer.size() / 1e6 << " MB from " << columns.size() << " recipes" << endl;
+    cout << "Dispatch picks: " << TextScan::kernelName() << endl;
+
+    const vector<string> needles = {"zzqx", "garlic butter", "chicken", " s", "-", "q"};
+    for (const string &needle : needles)
+    {
+        cout << "needle '" << needle << "':";
+        size_t expected = 0;
+        bool first = true;
+        for (const NamedKernel &kernel : kernels)
+        {
+            size_t hits = 0;
+            double gbps = throughput(buffer, [&]()
+                                     {
+                                         size_t found = 0;
+                                         size_t pos = 0;
+                                         while ((pos = kernel.find(buffer.data(), buffer.size(), needle.data(), needle.size(), pos)) != TextScan::npos)
+                                         {
+                                             found++;
+                                             pos++;
+                                         }
+                                         return found; },
+                                     hits);
+            if (first)
+                expected = hits;
+            first = false;
+            cout << "  " << kernel.name << " " << gbps << " GB/s" << (hits == expected ? "" : " (MISMATCH)");
+        }
+
+        size_t hits = 0;
+        double gbps = throughput(buffer, [&]()
+                                 {
+                                     string lower = Recipe::foldKey(buffer);
+                                     size_t found = 0;
+                                     for (size_t pos = lower.find(needle); pos != string::npos; pos = lower.find(needle, pos + 1))
+                                         found++;
+                                     return found; },
+                                 hits);
+        cout << "  | fold copy + find " << gbps << " GB/s" << (hits == expected ? "" : " (MISMATCH)")
+             << "  [" << expected << " hits]" << endl;
+    }
+    return 0;
+}
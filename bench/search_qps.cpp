@@ -0,0 +1,111 @@
+/*
+ * search_qps.cpp: 가짜 레시피 데이터베이스(기본 100만 개)에서 키워드 검색의 초당 질의 수(qps)를 잽니다.
+ *
+ * 빌드 (저장소 최상위에서):
+ *   g++ -std=c++17 -O2 -pthread -Isrc bench/search_qps.cpp -o search_qps
+ * 실행:
+ *   ./search_qps [레시피 수 = 1000000] [데이터 파일 = 임시 디렉터리/bench_recipes_<레시피 수>.txt]
+ *   데이터 파일이 없거나 레시피 수가 다르면 SyntheticRecipes.h로 다시 만듭니다. (100만 개: 약 360MB)
+ *
+ * 비교하는 방법
+ * - fold per query: 질의마다 모든 제목과 재료 이름을 소문자로 바꿔 비교 (미리 만든 소문자 키가 없던 방식)
+ * - indexed search: RecipeDatabase::findRecipes (미리 만든 소문자 키 + 역색인/트라이그램 색인)
+ * - title lookup: 대소문자를 섞은 제목으로 레시피 찾기 (editRecipe의 제목 찾기와 같은 경로)
+ */
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "RecipeDatabase.h"
+#include "SyntheticRecipes.h"
+
+using namespace std;
+
+// 모든 질의어 query(0..keyCount-1)를 한 바퀴씩, seconds초가 지날 때까지 반복해 초당 횟수와 평균 결과 수를 출력합니다.
+// (항상 바퀴 단위로 재므로 방법끼리 평균 결과 수가 같아야 합니다)
+template <typename Query>
+static void measure(const char *name, size_t keyCount, double seconds, Query query)
+{
+    auto start = chrono::steady_clock::now();
+    size_t runs = 0, hits = 0;
+    double elapsed = 0;
+    do
+    {
+        for (size_t i = 0; i < keyCount; i++)
+            hits += query(i);
+        runs += keyCount;
+        elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    } while (elapsed < seconds);
+    cout << "  " << name << ": " << runs / elapsed << " qps (avg hits " << hits / runs << ")" << endl;
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = argc > 1 ? stoul(argv[1]) : 1000000;
+    string path = argc > 2 ? argv[2] : defaultSyntheticPath("bench_recipes", count);
+
+    RecipeDatabase db;
+    db.setLazyProcedures(true);
+    double loadSeconds = 0;
+    if (!loadSyntheticRecipes(db, path, count, &loadSeconds))
+        return 1;
+    const vector<Recipe> &recipes = db.getRecipes();
+    cout << "Load time: " << loadSeconds << " s" << endl;
+    if (recipes.empty())
+        return 1;
+
+    // fold per query는 Recipe::foldKey로 비교할 때마다 새 소문자 문자열을 만듭니다. (이전 toLower와 같은 규칙/비용)
+    // 질의어: 넓은 검색(흔한 재료/제목 앞부분)과 좁은 검색(제목 뒷부분)
+    mt19937 rng(3);
+    vector<string> broad = {"chicken", "Soy Sauce", "GARLIC", "dish 12", "masala", "ing2999", "tomato", "cream", "rice", "xyz"};
+    for (int i = 0; i < 10; i++)
+    {
+        string title(recipes[rng() % recipes.size()].getTitle());
+        broad.push_back(title.substr(0, 4 + rng() % 8));
+    }
+    vector<string> selective, mixedCaseTitles;
+    for (int i = 0; i < 20; i++)
+    {
+        string title(recipes[rng() % recipes.size()].getTitle());
+        selective.push_back(title.substr(title.find(' ') + 1));
+        for (char &c : title)
+            c = (rng() % 2) ? static_cast<char>(toupper(static_cast<unsigned char>(c))) : static_cast<char>(tolower(static_cast<unsigned char>(c)));
+        mixedCaseTitles.push_back(title);
+    }
+
+    auto foldPerQuery = [&](const string &keyword)
+    {
+        string key = Recipe::foldKey(keyword);
+        size_t hits = 0;
+        for (const Recipe &recipe : recipes)
+        {
+            bool found = Recipe::foldKey(recipe.getTitle()).find(key) != string::npos;
+            for (size_t k = 0; !found && k < recipe.getIngredient().size(); k++)
+                found = Recipe::foldKey(recipe.ingredientName(recipe.getIngredient()[k])).find(key) != string::npos;
+            hits += found;
+        }
+        return hits;
+    };
+
+    const double seconds = 3.0;
+    cout << "selective search (" << selective.size() << " keys):" << endl;
+    measure("fold per query", selective.size(), seconds, [&](size_t i) { return foldPerQuery(selective[i]); });
+    measure("indexed search", selective.size(), seconds, [&](size_t i) { return db.findRecipes(selective[i]).size(); });
+
+    cout << "broad search (" << broad.size() << " keys):" << endl;
+    measure("fold per query", broad.size(), seconds, [&](size_t i) { return foldPerQuery(broad[i]); });
+    measure("indexed search", broad.size(), seconds, [&](size_t i) { return db.findRecipes(broad[i]).size(); });
+
+    cout << "title lookup, mixed case (" << mixedCaseTitles.size() << " keys):" << endl;
+    measure("fold per query", mixedCaseTitles.size(), seconds, [&](size_t i)
+            {
+                string key = Recipe::foldKey(mixedCaseTitles[i]);
+                for (const Recipe &recipe : recipes)
+                    if (Recipe::foldKey(recipe.getTitle()) == key)
+                        return size_t(1);
+                return size_t(0); });
+    measure("folded key index", mixedCaseTitles.size(), seconds, [&](size_t i)
+            { return db.getSearchIndex().rowsWithTitleKey(Recipe::foldKey(mixedCaseTitles[i]), recipes).size(); });
+    return 0;
+}
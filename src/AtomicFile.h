@@ -0,0 +1,215 @@
+#ifndef ATOMIC_FILE_H
+#define ATOMIC_FILE_H
+
+#include <string>           // std::string: 파일 경로, 오류 메시지
+#include <string_view>      // std::string_view: 쓸 데이터 조각을 복사 없이 전달하기 위해 포함
+#include <initializer_list> // 여러 조각을 한 번에 넘기기 위해 포함
+#include <chrono>           // 저장에 걸린 시간 측정
+#include <cstdio>           // rename, remove
+#include <cstdint>          // uint64_t
+#include <cstring>          // strerror
+#include <cerrno>           // errno
+
+#ifndef _WIN32
+#include <fcntl.h>    // open
+#include <sys/stat.h> // stat, fchmod: 원본 파일의 권한을 임시 파일에 옮기기 위해 포함
+#include <unistd.h>   // write, fsync, close
+#else
+#include <fstream> // POSIX 파일 API가 없는 환경의 대체 구현
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h> // MoveFileExW, MultiByteToWideChar
+#endif
+
+using namespace std;
+
+/*
+ * SyncPolicy: 저장할 때 디스크 동기화(fsync)를 얼마나 할지 정하는 정책
+ * - None: fsync 없음. 가장 빠르지만 정전/커널 오류 시 rename만 반영되고 내용은 비어 있을 수 있음
+ * - File: rename 전에 임시 파일 내용을 fsync. 교체된 파일은 항상 완전한 내용
+ * - FileAndDirectory: File + rename 후 디렉터리도 fsync하여 교체 자체가 디스크에 남도록 보장 (기본값)
+ */
+enum class SyncPolicy
+{
+    None,
+    File,
+    FileAndDirectory
+};
+
+inline string syncPolicyToString(SyncPolicy policy)
+{
+    switch (policy)
+    {
+    case SyncPolicy::None:
+        return "none";
+    case SyncPolicy::File:
+        return "file";
+    case SyncPolicy::FileAndDirectory:
+        return "file+directory";
+    }
+    return "unknown";
+}
+
+// 한 번의 원자적 저장 결과 (쓴 바이트 수와 걸린 시간)
+struct AtomicWriteResult
+{
+    bool ok = false;
+    uint64_t bytes = 0;
+    double seconds = 0.0; // 파일 쓰기 + 동기화 + rename에 걸린 시간
+    string error;
+};
+
+/**
+ * AtomicFile 클래스
+ * --------------------------
+ * 파일을 "전부 아니면 이전 그대로" 방식으로 교체하는 유틸리티.
+ * 1) 같은 디렉터리의 임시 파일(path.tmp)에 몇 번의 큰 write로 모든 내용을 쓰고
+ * 2) 정책에 따라 fsync한 뒤
+ * 3) rename으로 원본을 한 번에 교체합니다. (Windows: MoveFileExW(MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+ * 임시 파일은 원본이 있으면 원본과 같은 권한으로 만들어, 저장해도 파일 권한이 바뀌지 않습니다.
+ * 도중에 프로그램이 죽어도 원본은 이전 내용 그대로 남아 있습니다.
+ * 또한 원본을 제자리에서 덮어쓰지 않으므로, 원본을 mmap으로 읽고 있는 객체(지연 로딩)도 안전합니다.
+ */
+class AtomicFile
+{
+public:
+    static constexpr size_t kWriteChunk = 8u << 20; // write 한 번에 넘기는 최대 크기 (8MB)
+
+    /*
+     * static AtomicWriteResult write(const string &path, initializer_list<string_view> parts, SyncPolicy policy):
+     * parts를 순서대로 이어 붙인 내용으로 path를 원자적으로 교체합니다.
+     * details: 조각을 미리 하나로 합치지 않아도 되도록 여러 조각을 받습니다. (스냅샷의 헤더/테이블 등)
+     * return 성공 여부, 쓴 바이트 수, 걸린 시간
+     */
+    static AtomicWriteResult write(const string &path, initializer_list<string_view> parts, SyncPolicy policy)
+    {
+        AtomicWriteResult result;
+        auto start = chrono::steady_clock::now();
+        string tempPath = path + ".tmp";
+
+#ifndef _WIN32
+        int fd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+            return fail(result, "cannot create " + tempPath);
+
+        // 원본의 권한을 그대로 옮김 (open의 mode는 umask가 적용되고, 이미 있던 임시 파일에는 적용되지 않으므로 fchmod로 지정)
+        struct stat original;
+        if (::stat(path.c_str(), &original) == 0 && ::fchmod(fd, original.st_mode & 07777) != 0)
+        {
+            string reason = strerror(errno);
+            ::close(fd);
+            remove(tempPath.c_str());
+            return fail(result, "cannot copy permissions: " + reason);
+        }
+
+        for (string_view part : parts)
+        {
+            while (!part.empty())
+            {
+                ssize_t written = ::write(fd, part.data(), part.size() < kWriteChunk ? part.size() : kWriteChunk);
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    string reason = strerror(errno);
+                    ::close(fd);
+                    remove(tempPath.c_str());
+                    return fail(result, "write failed: " + reason);
+                }
+                part.remove_prefix(static_cast<size_t>(written));
+                result.bytes += static_cast<uint64_t>(written);
+            }
+        }
+
+        if (policy != SyncPolicy::None && ::fsync(fd) != 0)
+        {
+            string reason = strerror(errno);
+            ::close(fd);
+            remove(tempPath.c_str());
+            return fail(result, "fsync failed: " + reason);
+        }
+        if (::close(fd) != 0)
+        {
+            remove(tempPath.c_str());
+            return fail(result, "close failed");
+        }
+#else
+        // Windows: POSIX fsync가 없으므로 스트림으로 쓰고 MoveFileExW로 교체합니다. (동기화 정책 대신 MOVEFILE_WRITE_THROUGH)
+        ofstream file(tempPath, ios::binary | ios::trunc);
+        if (!file.is_open())
+            return fail(result, "cannot create " + tempPath);
+        for (string_view part : parts)
+        {
+            file.write(part.data(), static_cast<streamsize>(part.size()));
+            result.bytes += part.size();
+        }
+        file.close();
+        if (file.fail())
+        {
+            remove(tempPath.c_str());
+            return fail(result, "write failed");
+        }
+        // Windows의 rename은 대상 파일이 있으면 실패하므로, 원본을 지우지 않고 한 번에 바꾸는 MoveFileExW를 씀
+        if (!MoveFileExW(widen(tempPath).c_str(), widen(path).c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+        {
+            remove(tempPath.c_str());
+            return fail(result, "cannot replace " + path);
+        }
+#endif
+
+#ifndef _WIN32
+        if (rename(tempPath.c_str(), path.c_str()) != 0)
+        {
+            remove(tempPath.c_str());
+            return fail(result, "cannot replace " + path);
+        }
+        if (policy == SyncPolicy::FileAndDirectory)
+            syncDirectoryOf(path);
+#endif
+        result.ok = true;
+        result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+private:
+    static AtomicWriteResult fail(AtomicWriteResult &result, const string &error)
+    {
+        result.ok = false;
+        result.error = error;
+        return result;
+    }
+
+#ifdef _WIN32
+    // 경로를 ofstream/remove와 같은 코드 페이지(ANSI)로 해석해 UTF-16으로 바꿉니다.
+    static wstring widen(const string &text)
+    {
+        int length = MultiByteToWideChar(CP_ACP, 0, text.c_str(), -1, nullptr, 0);
+        if (length <= 0)
+            return wstring();
+        wstring wide(static_cast<size_t>(length), L'\0');
+        MultiByteToWideChar(CP_ACP, 0, text.c_str(), -1, &wide[0], length);
+        wide.resize(static_cast<size_t>(length - 1)); // 끝의 '\0' 제외
+        return wide;
+    }
+#endif
+
+#ifndef _WIN32
+    // rename으로 바뀐 디렉터리 항목을 디스크에 반영합니다.
+    static void syncDirectoryOf(const string &path)
+    {
+        size_t slash = path.find_last_of('/');
+        string directory = slash == string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+        int dirFd = ::open(directory.c_str(), O_RDONLY);
+        if (dirFd < 0)
+            return;
+        ::fsync(dirFd);
+        ::close(dirFd);
+    }
+#endif
+};
+
+#endif // ATOMIC_FILE_H
@@ -0,0 +1,52 @@
+#ifndef BIT_OPS_H
+#define BIT_OPS_H
+
+#include <cstdint> // uint32_t, uint64_t
+#if defined(_MSC_VER)
+#include <intrin.h> // _BitScanForward, _BitScanForward64, __popcnt64
+#endif
+
+/**
+ * BitOps 클래스
+ * --------------------------
+ * 비트 집합을 다루는 색인들(RowBitmap, PantryIndex, RecipeSearchIndex, TextScan)이 함께 쓰는 비트 연산.
+ * GCC/Clang은 내장 함수로, MSVC는 intrinsic으로 한 명령어가 되도록 컴파일됩니다.
+ */
+class BitOps
+{
+public:
+    // 1인 비트 수
+    static unsigned popcount(uint64_t bits)
+    {
+#if defined(_MSC_VER)
+        return static_cast<unsigned>(__popcnt64(bits));
+#else
+        return static_cast<unsigned>(__builtin_popcountll(bits));
+#endif
+    }
+
+    // 0이 아닌 bits에서 가장 낮은 1 비트의 위치
+    static unsigned lowestBit(uint64_t bits)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctzll(bits));
+#endif
+    }
+
+    static unsigned lowestBit(uint32_t bits)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, bits);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctz(bits));
+#endif
+    }
+};
+
+#endif // BIT_OPS_H
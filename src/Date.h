@@ -1,28 +1,201 @@
 #ifndef DATE_H
 #define DATE_H
 
+#include <cstddef>     // size_t
+#include <cstdint>     // int32_t
 #include <iostream>
 #include <string>
-#include <sstream>
+#include <string_view> // 날짜 문자열을 복사 없이 파싱하기 위해 포함
+
+/**
+ * CompactDate 구조체
+ * --------------------------
+ * 날짜와 시각을 정수 두 개(8바이트)로 나타냅니다.
+ * - day: 날짜 번호 (1970-01-01 == 0, 이전 날짜는 음수). 연속한 날은 연속한 번호이므로 날짜 더하기/빼기/비교가 정수 연산 한 번입니다.
+ * - minutes: 그날 0시부터 센 분 (hour * 60 + minute)
+ *
+ * 그레고리력 연-월-일과의 변환은 400년(146097일) 주기로 나누어 곱셈/나눗셈 몇 번으로 계산하며(반복 없음), constexpr이라 상수 날짜는 컴파일할 때 계산됩니다.
+ * 범위를 벗어난 필드는 모두 같은 규칙으로 정규화합니다: 넘치거나 모자란 만큼 바로 위 단위로 넘깁니다.
+ * (분 -> 시, 시 -> 일, 일 -> 월, 월 -> 연. 예: 13월 == 다음 해 1월, 2월 30일 == 3월 1일 또는 2일, 25시 == 다음 날 1시)
+ * 문자열로 바꿀 때는 호출하는 쪽의 버퍼에 씁니다. (stringstream/할당 없음)
+ */
+struct CompactDate
+{
+    // format()에 넘길 버퍼 크기: "-YYYYYY-MM-DD HH:MM" + '\0'이 들어감
+    static constexpr size_t kFormatSize = 24;
+
+    int32_t day = 0;
+    int32_t minutes = 0;
+
+    struct Civil
+    {
+        int year;
+        int month;
+        int day;
+    };
+
+    static constexpr bool isLeapYear(int y)
+    {
+        return (y % 4 == 0 && y % 100 != 0) || (y % 400 == 0);
+    }
+
+    static constexpr int daysInMonth(int y, int m)
+    {
+        return m == 2 ? (isLeapYear(y) ? 29 : 28) : (m == 4 || m == 6 || m == 9 || m == 11) ? 30 : 31;
+    }
+
+    // a / b를 내림한 몫 (b > 0, a가 음수여도 내림)
+    static constexpr int floorDiv(int a, int b)
+    {
+        return a >= 0 ? a / b : -((-a + b - 1) / b);
+    }
+
+    /*
+     * static constexpr int32_t daysFromCivil(int y, int m, int d): 그레고리력 y-m-d의 날짜 번호
+     * details: 1-12를 벗어난 월은 연으로 넘기고(13월 == 다음 해 1월, 0월 == 전 해 12월),
+     *          달력에 없는 일(2월 30일, 0일 등)은 넘치거나 모자란 만큼 이웃한 달로 이어집니다. (2월 30일 == 3월 1일 또는 2일)
+     */
+    static constexpr int32_t daysFromCivil(int y, int m, int d)
+    {
+        int yearCarry = floorDiv(m - 1, 12);
+        y += yearCarry;
+        m -= yearCarry * 12;
+        y -= m <= 2;
+        int era = (y >= 0 ? y : y - 399) / 400;
+        int yearOfEra = y - era * 400;                                  // [0, 399]
+        int dayOfYear = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1; // 3월 1일부터 센 날 [0, 365]
+        int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468;
+    }
+
+    // 날짜 번호 -> 그레고리력 연-월-일 (daysFromCivil의 역)
+    static constexpr Civil civilFromDays(int32_t z)
+    {
+        z += 719468;
+        int era = (z >= 0 ? z : z - 146096) / 146097;
+        int dayOfEra = z - era * 146097;
+        int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        int mp = (5 * dayOfYear + 2) / 153;
+        int d = dayOfYear - (153 * mp + 2) / 5 + 1;
+        int m = mp < 10 ? mp + 3 : mp - 9;
+        return Civil{yearOfEra + era * 400 + (m <= 2), m, d};
+    }
+
+    // 날짜 번호 day의 0시부터 minutes분 뒤 (minutes가 하루를 넘거나 음수면 날짜로 넘김)
+    static constexpr CompactDate normalized(int32_t day, int minutes)
+    {
+        int dayCarry = floorDiv(minutes, 24 * 60);
+        return CompactDate{day + dayCarry, minutes - dayCarry * 24 * 60};
+    }
+
+    // y-m-d hour:minute. 범위를 벗어난 필드는 위 단위로 넘깁니다. (25시 == 다음 날 1시, 13월 == 다음 해 1월)
+    static constexpr CompactDate fromCivil(int y, int m, int d, int hour = 0, int minute = 0)
+    {
+        return normalized(daysFromCivil(y, m, d), hour * 60 + minute);
+    }
+
+    constexpr Civil toCivil() const { return civilFromDays(day); }
+    constexpr int hour() const { return minutes / 60; }
+    constexpr int minute() const { return minutes % 60; }
+
+    // n일 뒤 (음수면 앞) 같은 시각
+    constexpr CompactDate plusDays(int n) const { return CompactDate{day + n, minutes}; }
+
+    constexpr bool operator==(const CompactDate &other) const { return day == other.day && minutes == other.minutes; }
+    constexpr bool operator!=(const CompactDate &other) const { return !(*this == other); }
+    constexpr bool operator<(const CompactDate &other) const
+    {
+        return day != other.day ? day < other.day : minutes < other.minutes;
+    }
+
+    /*
+     * size_t format(char *buffer, size_t size, bool withTime = true) const: "YYYY-MM-DD HH:MM"(withTime이 false면 "YYYY-MM-DD")를
+     * buffer에 쓰고 '\0'으로 끝냅니다. 연도는 최소 4자리, 월/일/시/분은 2자리로 0을 채웁니다.
+     * details: size가 kFormatSize 이상이면 항상 전부 들어갑니다. 작으면 들어가는 만큼만 씁니다.
+     * return 쓴 글자 수 ('\0' 제외)
+     */
+    size_t format(char *buffer, size_t size, bool withTime = true) const
+    {
+        char text[kFormatSize];
+        size_t length = 0;
+        Civil civil = toCivil();
+        auto putNumber = [&](long value, int width)
+        {
+            char digits[12];
+            int count = 0;
+            bool negative = value < 0;
+            unsigned long magnitude = negative ? 0UL - static_cast<unsigned long>(value) : static_cast<unsigned long>(value);
+            do
+            {
+                digits[count++] = static_cast<char>('0' + magnitude % 10);
+                magnitude /= 10;
+            } while (magnitude != 0 && count < 11);
+            if (negative)
+                text[length++] = '-';
+            for (int pad = count; pad < width; pad++)
+                text[length++] = '0';
+            while (count > 0)
+                text[length++] = digits[--count];
+        };
+        putNumber(civil.year, 4);
+        text[length++] = '-';
+        putNumber(civil.month, 2);
+        text[length++] = '-';
+        putNumber(civil.day, 2);
+        if (withTime)
+        {
+            text[length++] = ' ';
+            putNumber(hour(), 2);
+            text[length++] = ':';
+            putNumber(minute(), 2);
+        }
+        if (size == 0)
+            return 0;
+        size_t written = length < size - 1 ? length : size - 1;
+        for (size_t i = 0; i < written; i++)
+            buffer[i] = text[i];
+        buffer[written] = '\0';
+        return written;
+    }
+};
+
+static_assert(CompactDate::daysFromCivil(1970, 1, 1) == 0, "날짜 번호 기준일");
+static_assert(CompactDate::civilFromDays(CompactDate::daysFromCivil(2000, 2, 29)).day == 29, "윤일 왕복");
+static_assert(CompactDate::daysFromCivil(2024, 13, 1) == CompactDate::daysFromCivil(2025, 1, 1), "월은 연으로 넘김");
+static_assert(CompactDate::fromCivil(2024, 1, 1, 25, 0) == CompactDate::fromCivil(2024, 1, 2, 1, 0), "시는 날짜로 넘김");
+
+// Date::tryParse 실패 정보: 틀린 위치(0부터 센 글자 번호)와 이유
+struct DateParseError
+{
+    size_t position = 0;
+    const char *reason = "";
+};
 
 class Date
 {
 private:
-    int year;
-    int month;
-    int day;
-    int hour;
-    int minute;
+    CompactDate when; // 날짜 번호 + 분 (연/월/일/시/분은 필요할 때 계산)
     std::string description;
     std::string recipeName;
 
+    // y년 m월(넘치면 연으로 넘김)의 day일, 그 달에 없는 날이면 마지막 날
+    void setMonthOf(int y, int m, int day)
+    {
+        int yearCarry = CompactDate::floorDiv(m - 1, 12);
+        y += yearCarry;
+        m -= yearCarry * 12;
+        int last = CompactDate::daysInMonth(y, m);
+        when.day = CompactDate::daysFromCivil(y, m, day < last ? day : last);
+    }
+
 public:
     // 기본 생성자
-    Date() : year(2024), month(1), day(1), hour(0), minute(0), description(""), recipeName("") {}
+    Date() : when(CompactDate::fromCivil(2024, 1, 1)), description(""), recipeName("") {}
 
-    // 매개변수 생성자
+    // 매개변수 생성자 (범위를 벗어난 필드는 CompactDate::fromCivil처럼 위 단위로 넘김)
     Date(int y, int m, int d, int h, int min, const std::string &desc = "", const std::string &recipe = "")
-        : year(y), month(m), day(d), hour(h), minute(min), description(desc), recipeName(recipe) {}
+        : when(CompactDate::fromCivil(y, m, d, h, min)), description(desc), recipeName(recipe) {}
 
     // 문자열로부터 생성하는 생성자 (예: "2024-10-02 14:00 - Meeting with team")
     Date(const std::string &dateString)
@@ -30,167 +203,268 @@ public:
         parseFromString(dateString);
     }
 
-    // 문자열 파싱 함수
-    void parseFromString(const std::string &dateString)
+    /*
+     * static bool tryParse(std::string_view text, Date &out, DateParseError *error = nullptr):
+     * "YYYY-MM-DD[ HH[:MM]] - 설명[ - 레시피]" 형식의 일정 한 줄을 한 번 훑어 out에 담습니다. 예외를 던지지 않습니다.
+     * details: 월/일/시/분은 한 자리도 받고, 시각이 없으면 00:00입니다. 설명은 첫 " - " 뒤부터 다음 " - " 앞까지, 레시피는 그 뒤 전부입니다.
+     *          달력에 없는 날짜(2월 30일 등)나 범위를 벗어난 시각은 실패입니다.
+     * return 성공 여부. 실패하면 out은 그대로이고, error가 있으면 틀린 위치(0부터 센 글자 번호)와 이유를 담습니다.
+     */
+    static bool tryParse(std::string_view text, Date &out, DateParseError *error = nullptr)
     {
-        // 기본값 설정
-        year = 2024;
-        month = 1;
-        day = 1;
-        hour = 0;
-        minute = 0;
-        description = "";
-        recipeName = "";
-
-        // 형식: "2024-10-02 14:00 - Meeting - Recipe_name"
-        size_t firstDashPos = dateString.find(" - ");
-        if (firstDashPos != std::string::npos)
+        size_t i = 0;
+        auto fail = [&](const char *reason)
         {
-            std::string datePart = dateString.substr(0, firstDashPos);
-            std::string remainingPart = dateString.substr(firstDashPos + 3);
-
-            // 두 번째 " - "를 찾아서 description과 recipeName 분리
-            size_t secondDashPos = remainingPart.find(" - ");
-            if (secondDashPos != std::string::npos)
+            if (error != nullptr)
             {
-                description = remainingPart.substr(0, secondDashPos);
-                recipeName = remainingPart.substr(secondDashPos + 3);
+                error->position = i;
+                error->reason = reason;
             }
-            else
+            return false;
+        };
+        // 최대 maxDigits자리 숫자를 읽어 [low, high] 범위인지 확인 (실패하면 i는 숫자 시작 위치)
+        auto readNumber = [&](int maxDigits, int low, int high, int &value)
+        {
+            size_t begin = i;
+            value = 0;
+            while (i < text.size() && i - begin < static_cast<size_t>(maxDigits) && text[i] >= '0' && text[i] <= '9')
+                value = value * 10 + (text[i++] - '0');
+            bool ok = i > begin && value >= low && value <= high;
+            if (!ok)
+                i = begin;
+            return ok;
+        };
+        auto expect = [&](char c)
+        {
+            if (i < text.size() && text[i] == c)
             {
-                // 레시피 이름이 없는 경우, 전체를 description으로
-                description = remainingPart;
+                i++;
+                return true;
             }
+            return false;
+        };
 
-            // 날짜와 시간 파싱
-            std::stringstream ss(datePart);
-            std::string token;
-
-            // 년-월-일 파싱
-            if (std::getline(ss, token, '-'))
-                year = std::stoi(token);
-            if (std::getline(ss, token, '-'))
-                month = std::stoi(token);
-            if (std::getline(ss, token, ' '))
-                day = std::stoi(token);
-
-            // 시:분 파싱
-            if (std::getline(ss, token, ':'))
-                hour = std::stoi(token);
-            if (std::getline(ss, token))
-                minute = std::stoi(token);
+        while (i < text.size() && (text[i] == ' ' || text[i] == '\t'))
+            i++;
+
+        int year, month, day, hour = 0, minute = 0;
+        if (!readNumber(4, 1, 9999, year))
+            return fail("expected a year (1-4 digits)");
+        if (!expect('-'))
+            return fail("expected '-' after the year");
+        if (!readNumber(2, 1, 12, month))
+            return fail("month must be 1-12");
+        if (!expect('-'))
+            return fail("expected '-' after the month");
+        size_t dayStart = i;
+        if (!readNumber(2, 1, 31, day) || day > CompactDate::daysInMonth(year, month))
+        {
+            i = dayStart;
+            return fail("day does not exist in that month");
+        }
+
+        // 시각 (선택): 공백 뒤 숫자가 오면 시각으로 읽음
+        size_t afterDate = i;
+        while (i < text.size() && text[i] == ' ')
+            i++;
+        if (i > afterDate && i < text.size() && text[i] >= '0' && text[i] <= '9')
+        {
+            if (!readNumber(2, 0, 23, hour))
+                return fail("hour must be 0-23");
+            if (expect(':') && !readNumber(2, 0, 59, minute))
+                return fail("minute must be 0-59");
+            while (i < text.size() && text[i] == ' ')
+                i++;
+        }
+
+        // " - " 구분자: 날짜/시각 뒤 공백이 하나 이상 있어야 함
+        if (i == afterDate || i + 1 >= text.size() || text[i] != '-' || text[i + 1] != ' ')
+            return fail("expected ' - ' before the description");
+        i += 2;
+
+        std::string_view rest = text.substr(i);
+        size_t split = rest.find(" - ");
+        out.when = CompactDate::fromCivil(year, month, day, hour, minute);
+        if (split == std::string_view::npos)
+        {
+            out.description.assign(rest.data(), rest.size());
+            out.recipeName.clear();
         }
         else
         {
-            // " - "가 없는 경우, 전체를 description으로
-            description = dateString;
+            out.description.assign(rest.data(), split);
+            out.recipeName.assign(rest.data() + split + 3, rest.size() - split - 3);
         }
+        return true;
     }
 
-    // Getter 함수들
-    int getYear() const { return year; }
-    int getMonth() const { return month; }
-    int getDay() const { return day; }
-    int getHour() const { return hour; }
-    int getMinute() const { return minute; }
+    /*
+     * void parseFromString(const std::string &dateString): tryParse로 일정 문자열을 읽습니다.
+     * details: 형식에 맞지 않으면 날짜는 기본값(2024-01-01 00:00)으로 두고 문자열 전체를 설명으로 씁니다.
+     */
+    void parseFromString(const std::string &dateString)
+    {
+        if (tryParse(dateString, *this))
+            return;
+        when = CompactDate::fromCivil(2024, 1, 1);
+        description = dateString;
+        recipeName = "";
+    }
+
+    // Getter 함수들 (연/월/일은 날짜 번호에서 계산)
+    int getYear() const { return when.toCivil().year; }
+    int getMonth() const { return when.toCivil().month; }
+    int getDay() const { return when.toCivil().day; }
+    int getHour() const { return when.hour(); }
+    int getMinute() const { return when.minute(); }
     std::string getDescription() const { return description; }
     std::string getRecipeName() const { return recipeName; }
+    CompactDate getCompact() const { return when; }
 
-    // Setter 함수들
-    void setYear(int y) { year = y; }
-    void setMonth(int m) { month = m; }
-    void setDay(int d) { day = d; }
-    void setHour(int h) { hour = h; }
-    void setMinute(int min) { minute = min; }
+    /*
+     * Setter 함수들: 나머지 필드는 그대로 두고 날짜 번호를 다시 계산합니다. 범위를 벗어난 값은 생성자와 같이 위 단위로 넘깁니다.
+     * details: 연/월만 바꿀 때 지금의 일이 새 달에 없으면 그 달의 마지막 날이 됩니다. (1월 31일에 setMonth(2) -> 2월 28일 또는 29일)
+     *          연-월-일을 한꺼번에 바꿀 때는 setDate를 씁니다. (필드를 하나씩 바꾸면 중간 날짜가 달력에 없을 수 있음)
+     */
+    void setDate(int y, int m, int d) { when.day = CompactDate::daysFromCivil(y, m, d); }
+    void setYear(int y)
+    {
+        CompactDate::Civil c = when.toCivil();
+        setMonthOf(y, c.month, c.day);
+    }
+    void setMonth(int m)
+    {
+        CompactDate::Civil c = when.toCivil();
+        setMonthOf(c.year, m, c.day);
+    }
+    void setDay(int d)
+    {
+        CompactDate::Civil c = when.toCivil();
+        when.day = CompactDate::daysFromCivil(c.year, c.month, d);
+    }
+    void setHour(int h) { when = CompactDate::normalized(when.day, h * 60 + when.minute()); }
+    void setMinute(int min) { when = CompactDate::normalized(when.day, when.hour() * 60 + min); }
     void setDescription(const std::string &desc) { description = desc; }
     void setRecipeName(const std::string &recipe) { recipeName = recipe; }
 
-    // 날짜를 문자열로 변환
+    // 날짜를 문자열로 변환 ("YYYY-MM-DD HH:MM - 설명 - 레시피")
     std::string toString() const
     {
-        std::stringstream ss;
-        ss << year << "-";
-        if (month < 10)
-            ss << "0";
-        ss << month << "-";
-        if (day < 10)
-            ss << "0";
-        ss << day << " ";
-        if (hour < 10)
-            ss << "0";
-        ss << hour << ":";
-        if (minute < 10)
-            ss << "0";
-        ss << minute;
+        char buffer[CompactDate::kFormatSize];
+        std::string text(buffer, when.format(buffer, sizeof(buffer)));
 
         if (!description.empty())
         {
-            ss << " - " << description;
+            text += " - ";
+            text += description;
         }
 
         if (!recipeName.empty())
         {
-            ss << " - " << recipeName;
+            text += " - ";
+            text += recipeName;
         }
 
-        return ss.str();
+        return text;
     }
 
     // 출력 연산자 오버로딩
     friend std::ostream &operator<<(std::ostream &os, const Date &date)
     {
-        os << date.toString();          
+        os << date.toString();
         return os;
     }
 
     // 윤년인지 확인하는 헬퍼 함수
-    bool isLeapYear(int y) const {
-        return (y % 4 == 0 && y % 100 != 0) || (y % 400 == 0);
+    static bool isLeapYear(int y) {
+        return CompactDate::isLeapYear(y);
     }
 
     // 해당 월의 마지막 날짜를 반환하는 헬퍼 함수
-    int daysInMonth(int y, int m) const {
-        if (m == 2) {
-            return isLeapYear(y) ? 29 : 28;
-        } else if (m == 4 || m == 6 || m == 9 || m == 11) {
-            return 30;
-        } else {
-            return 31;
-        }
+    static int daysInMonth(int y, int m) {
+        return CompactDate::daysInMonth(y, m);
     }
 
-    // 날짜를 하루 증가시키는 함수
+    // 날짜를 하루 증가시키는 함수 (날짜 번호 + 1)
     void incrementDay() {
-        day++;
-        if (day > daysInMonth(year, month)) {
-            day = 1;
-            month++;
-            if (month > 12) {
-                month = 1;
-                year++;
+        when.day++;
+    }
+
+    // 날짜를 n일 옮기는 함수 (음수면 앞으로). 달/해 경계와 관계없이 O(1)
+    void addDays(int n) {
+        when.day += n;
+    }
+
+    // --- 날짜 번호 (1970-01-01부터 센 날 수) ---
+    // 식단 달력처럼 날짜를 키로 쓰는 곳은 문자열 대신 이 정수를 씁니다. (연속한 날은 연속한 번호)
+
+    static int daysFromCivil(int y, int m, int d) { return CompactDate::daysFromCivil(y, m, d); }
+
+    // 날짜 번호 -> 그레고리력 y-m-d (daysFromCivil의 역)
+    static void civilFromDays(int z, int &y, int &m, int &d)
+    {
+        CompactDate::Civil c = CompactDate::civilFromDays(z);
+        y = c.year;
+        m = c.month;
+        d = c.day;
+    }
+
+    // 이 날짜(시각 제외)의 날짜 번호
+    int toEpochDay() const { return when.day; }
+
+    /*
+     * static bool parseDay(std::string_view text, int &epochDay): "YYYY-MM-DD" 형식의 날짜를 날짜 번호로 바꿉니다.
+     * details: 앞뒤 공백은 무시하고, 월/일은 한 자리도 받습니다. ("2024-3-5") 달력에 없는 날짜(2월 30일 등)는 실패입니다.
+     * return 성공 여부 (실패하면 epochDay는 그대로)
+     */
+    static bool parseDay(std::string_view text, int &epochDay)
+    {
+        size_t i = 0, n = text.size();
+        while (i < n && (text[i] == ' ' || text[i] == '\t'))
+            i++;
+        while (n > i && (text[n - 1] == ' ' || text[n - 1] == '\t' || text[n - 1] == '\r'))
+            n--;
+        int parts[3] = {0, 0, 0};
+        const int maxDigits[3] = {4, 2, 2};
+        for (int k = 0; k < 3; k++)
+        {
+            if (k > 0)
+            {
+                if (i >= n || text[i] != '-')
+                    return false;
+                i++;
             }
+            int digits = 0;
+            while (i < n && text[i] >= '0' && text[i] <= '9' && digits < maxDigits[k])
+            {
+                parts[k] = parts[k] * 10 + (text[i++] - '0');
+                digits++;
+            }
+            if (digits == 0)
+                return false;
         }
+        if (i != n || parts[0] < 1 || parts[1] < 1 || parts[1] > 12 || parts[2] < 1 || parts[2] > daysInMonth(parts[0], parts[1]))
+            return false;
+        epochDay = daysFromCivil(parts[0], parts[1], parts[2]);
+        return true;
+    }
+
+    // 날짜 번호 -> "YYYY-MM-DD" (버퍼에 바로 쓰려면 CompactDate::format 사용)
+    static std::string formatDay(int epochDay)
+    {
+        char buffer[CompactDate::kFormatSize];
+        return std::string(buffer, CompactDate{epochDay, 0}.format(buffer, sizeof(buffer), false));
     }
 
-    // '작거나 같음' 비교 연산자 (루프 종료 조건에 사용)
+    // '작거나 같음' 비교 연산자 (루프 종료 조건에 사용, 날짜만 비교)
     bool operator<=(const Date& other) const {
-        if (year != other.year) return year < other.year;
-        if (month != other.month) return month < other.month;
-        return day <= other.day;
+        return when.day <= other.when.day;
     }
 
     // 비교 연산자 (날짜 정렬을 위해)
     bool operator<(const Date &other) const
     {
-        if (year != other.year)
-            return year < other.year;
-        if (month != other.month)
-            return month < other.month;
-        if (day != other.day)
-            return day < other.day;
-        if (hour != other.hour)
-            return hour < other.hour;
-        return minute < other.minute;
+        return when < other.when;
     }
 };
 
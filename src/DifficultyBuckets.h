@@ -0,0 +1,148 @@
+#ifndef DIFFICULTY_BUCKETS_H
+#define DIFFICULTY_BUCKETS_H
+
+#include <algorithm> // std::sort
+#include <cstdint>   // uint32_t
+#include <vector>
+#include "Recipe.h"
+#include "RecipeSlotMap.h" // 레시피 id -> 현재 행 번호
+
+using namespace std;
+
+/**
+ * DifficultyRows 클래스
+ * --------------------------
+ * 난이도 버킷 몇 개를 이어 붙인 것처럼 보여주는 뷰. id를 복사하지 않고, 읽을 때 레시피 id를 현재 행 번호로 바꿉니다.
+ * - 순서는 버킷을 넘긴 순서대로이며, 버킷 안의 순서는 목록(행) 순서가 아닙니다. 목록 순서가 필요하면 sortedRows()를 씁니다.
+ * - 레시피 목록이 바뀌면(삽입/수정/삭제/정렬) 더 이상 유효하지 않습니다.
+ */
+class DifficultyRows
+{
+private:
+    const vector<uint32_t> *parts[3] = {nullptr, nullptr, nullptr};
+    size_t partCount = 0;
+    size_t total = 0;
+    const RecipeSlotMap *slots = nullptr;
+
+public:
+    DifficultyRows() = default;
+    DifficultyRows(const vector<uint32_t> &ids, const RecipeSlotMap &slotMap) : slots(&slotMap) { appendIds(ids); }
+
+    void appendIds(const vector<uint32_t> &ids)
+    {
+        parts[partCount++] = &ids;
+        total += ids.size();
+    }
+
+    // other의 버킷을 뒤에 이어 붙입니다. (같은 RecipeDatabase에서 나온 뷰끼리)
+    void append(const DifficultyRows &other)
+    {
+        if (slots == nullptr)
+            slots = other.slots;
+        for (size_t p = 0; p < other.partCount; p++)
+            appendIds(*other.parts[p]);
+    }
+
+    size_t size() const { return total; }
+    bool empty() const { return total == 0; }
+
+    // i번째 레시피의 행 번호 (0 <= i < size())
+    uint32_t operator[](size_t i) const
+    {
+        size_t p = 0;
+        while (i >= parts[p]->size())
+            i -= parts[p++]->size();
+        return slots->rowOf((*parts[p])[i]);
+    }
+
+    /*
+     * void forEach(Visitor visit) const: 뷰의 레시피마다 visit(row)를 뷰 순서대로 호출합니다.
+     */
+    template <typename Visitor>
+    void forEach(Visitor visit) const
+    {
+        for (size_t p = 0; p < partCount; p++)
+        {
+            for (uint32_t id : *parts[p])
+                visit(slots->rowOf(id));
+        }
+    }
+
+    // 뷰의 행 번호를 목록 순서(오름차순)로 복사해 돌려줍니다. O(k log k)
+    vector<uint32_t> sortedRows() const
+    {
+        vector<uint32_t> rows;
+        rows.reserve(total);
+        forEach([&](uint32_t row) { rows.push_back(row); });
+        sort(rows.begin(), rows.end());
+        return rows;
+    }
+};
+
+/**
+ * DifficultyBuckets 클래스
+ * --------------------------
+ * 난이도(A, B, C)마다 그 난이도인 레시피의 id(RecipeSearchIndex가 주는, 삭제/정렬에도 바뀌지 않는 번호)를 보관합니다.
+ * - 버킷 안의 위치를 id별로 기억해 두어, 빼기는 마지막 원소를 그 자리로 옮기는 O(1)입니다.
+ * - id는 행 번호가 아니므로 다른 레시피의 삭제나 정렬로는 바뀌지 않습니다. (삭제는 지운 레시피만, 정렬은 아무것도 고치지 않음)
+ * 로딩할 때 한 번 만들고, 삽입/수정/삭제 때는 바뀐 레시피의 id만 옮깁니다.
+ */
+class DifficultyBuckets
+{
+private:
+    vector<uint32_t> buckets[3];  // Difficulty 값(A=0, B=1, C=2) 순서, 레시피 id
+    vector<uint32_t> positionOf;  // 레시피 id -> 자기 버킷 안의 위치
+
+    static size_t indexOf(Difficulty d) { return static_cast<size_t>(d); }
+
+public:
+    void clear()
+    {
+        for (auto &bucket : buckets)
+            bucket.clear();
+        positionOf.clear();
+    }
+
+    // id의 레시피(난이도 d)를 넣습니다.
+    void insert(uint32_t id, Difficulty d)
+    {
+        vector<uint32_t> &bucket = buckets[indexOf(d)];
+        if (id >= positionOf.size())
+            positionOf.resize(id + 1);
+        positionOf[id] = static_cast<uint32_t>(bucket.size());
+        bucket.push_back(id);
+    }
+
+    // id의 레시피(난이도 d)를 뺍니다. 버킷의 마지막 id를 빈 자리로 옮깁니다.
+    void erase(uint32_t id, Difficulty d)
+    {
+        vector<uint32_t> &bucket = buckets[indexOf(d)];
+        uint32_t position = positionOf[id];
+        uint32_t last = bucket.back();
+        bucket[position] = last;
+        positionOf[last] = position;
+        bucket.pop_back();
+    }
+
+    // id의 난이도가 from에서 to로 바뀜
+    void change(uint32_t id, Difficulty from, Difficulty to)
+    {
+        if (from == to)
+            return;
+        erase(id, from);
+        insert(id, to);
+    }
+
+    DifficultyRows rowsOf(Difficulty d, const RecipeSlotMap &slots) const { return DifficultyRows(buckets[indexOf(d)], slots); }
+
+    // maxLevel 이하(같거나 쉬운) 난이도의 레시피: 쉬운 것(C)부터 어려운 것(A) 순서
+    DifficultyRows rowsUpTo(Difficulty maxLevel, const RecipeSlotMap &slots) const
+    {
+        DifficultyRows view;
+        for (size_t d = 3; d-- > indexOf(maxLevel);)
+            view.append(DifficultyRows(buckets[d], slots));
+        return view;
+    }
+};
+
+#endif // DIFFICULTY_BUCKETS_H
@@ -0,0 +1,149 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>      // std::string: 파일 경로 및 (Windows) 대체 버퍼
+#include <string_view> // std::string_view: 매핑된 메모리를 복사 없이 노출하기 위해 포함
+#include <fstream>     // std::ifstream: mmap을 쓸 수 없는 환경에서 파일 전체를 읽기 위해 포함
+
+#ifndef _WIN32
+#include <fcntl.h>    // open
+#include <sys/mman.h> // mmap, munmap, madvise
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // close
+#endif
+
+using namespace std;
+
+/**
+ * MappedFile 클래스
+ * --------------------------
+ * 파일 전체를 읽기 전용으로 메모리에 매핑(mmap)하여 string_view로 보여주는 RAII 클래스.
+ * - POSIX 환경: mmap을 사용하므로 파일 내용을 별도 버퍼로 복사하지 않습니다.
+ * - 그 외 환경(Windows): 파일 전체를 한 번에 읽어 내부 버퍼에 보관합니다.
+ *
+ * 객체가 살아있는 동안만 view()가 가리키는 메모리가 유효합니다.
+ * 복사는 금지하고 이동만 허용합니다.
+ */
+class MappedFile
+{
+private:
+    const char *base = nullptr; // 매핑된 메모리의 시작 주소
+    size_t length = 0;          // 파일 크기 (바이트)
+    bool opened = false;
+#ifdef _WIN32
+    string buffer; // mmap 대체 버퍼
+#endif
+
+    void release()
+    {
+#ifndef _WIN32
+        if (base != nullptr && length > 0)
+            munmap(const_cast<char *>(base), length);
+#else
+        buffer.clear();
+        buffer.shrink_to_fit();
+#endif
+        base = nullptr;
+        length = 0;
+        opened = false;
+    }
+
+public:
+    MappedFile() = default;
+    explicit MappedFile(const string &path) { open(path); }
+    ~MappedFile() { release(); }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    MappedFile(MappedFile &&other) noexcept { *this = std::move(other); }
+    MappedFile &operator=(MappedFile &&other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            base = other.base;
+            length = other.length;
+            opened = other.opened;
+#ifdef _WIN32
+            buffer = std::move(other.buffer);
+            base = buffer.data();
+#endif
+            other.base = nullptr;
+            other.length = 0;
+            other.opened = false;
+        }
+        return *this;
+    }
+
+    /*
+     * bool open(const string &path): 파일을 읽기 전용으로 매핑합니다.
+     * details: 크기가 0인 파일은 mmap이 실패하므로 매핑 없이 빈 view로 성공 처리합니다.
+     * 순차적으로 읽는 용도이므로 madvise(MADV_SEQUENTIAL)로 커널에 미리 읽기를 요청합니다.
+     * return 성공 시 true, 파일을 열 수 없으면 false
+     */
+    bool open(const string &path)
+    {
+        release();
+#ifndef _WIN32
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat st;
+        if (fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        length = static_cast<size_t>(st.st_size);
+        if (length > 0)
+        {
+            void *p = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED)
+            {
+                ::close(fd);
+                length = 0;
+                return false;
+            }
+            madvise(p, length, MADV_SEQUENTIAL);
+            base = static_cast<const char *>(p);
+        }
+        ::close(fd); // 매핑은 fd를 닫아도 유지됩니다.
+#else
+        ifstream file(path, ios::binary | ios::ate);
+        if (!file.is_open())
+            return false;
+        buffer.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(&buffer[0], static_cast<streamsize>(buffer.size()));
+        base = buffer.data();
+        length = buffer.size();
+#endif
+        opened = true;
+        return true;
+    }
+
+    /*
+     * void dropResidentPages(): 지금까지 읽어 메모리에 올라온 페이지를 커널에 돌려줍니다.
+     * details: 매핑은 그대로 유지되므로 나중에 다시 접근하면 파일에서 다시 읽힙니다.
+     * 로딩이 끝난 뒤 가끔씩만 읽는 영역(조리 절차 등)을 위해, 접근 패턴도 '무작위'로 바꿔 둡니다.
+     */
+    void dropResidentPages()
+    {
+#ifndef _WIN32
+        if (base != nullptr && length > 0)
+        {
+            madvise(const_cast<char *>(base), length, MADV_DONTNEED);
+            madvise(const_cast<char *>(base), length, MADV_RANDOM);
+        }
+#endif
+    }
+
+    bool isOpen() const { return opened; }
+    size_t size() const { return length; }
+    string_view view() const { return string_view(base, length); }
+};
+
+#endif // MAPPED_FILE_H
@@ -15,9 +15,13 @@ using namespace std;
  * --------------------------
  * 한 끼니(아침/점심/저녁)에 포함된 Recipe들을 관리하는 클래스.
  * - mealType: Breakfast / Lunch / Dinner 등 구분
- * - recipes: 해당 끼니에 포함된 Recipe 객체 리스트
+ * - recipes: 해당 끼니에 포함된 레시피의 핸들(RecipeHandle) 리스트
  * - servings: 인분 수
  *
+ * 레시피를 복사하지 않고 8바이트 핸들만 저장하며, 제목/재료가 필요할 때 RecipeDatabase에서 찾습니다.
+ * 그래서 식단이 길어져도 메모리는 끼니 수에 비례하고, 레시피를 수정하면 식단에도 바로 반영됩니다.
+ * 데이터베이스에서 삭제된 레시피는 출력/장보기 목록에서 빠집니다.
+ *
  * 주요 기능:
  *  - addRecipe(): RecipeDatabase에서 이름으로 레시피를 찾아 추가
  *  - removeRecipe(): 레시피 삭제
@@ -28,33 +32,37 @@ using namespace std;
 class Meal {
     private: 
     string mealType; // 아침, 점심, 저녁 구분   
-    vector<Recipe> recipes; // 그 끼니에 포함된 요리 이름 목록. 레시피 객체 리스트
+    vector<RecipeHandle> recipes; // 그 끼니에 포함된 레시피 핸들 목록
     int servings; // 몇 인분인지
+    const RecipeDatabase *db = nullptr; // 핸들을 찾을 데이터베이스 (처음 addRecipe할 때 정해짐)
 
     public:
     //생성자
     Meal(string type = "Meal", int s = 1) : mealType(type), servings(s) {} // 기본 1인분
 
-    //레시피 추가
-    void addRecipe(const RecipeDatabase &db, const string &recipeName)
+    //레시피 추가 (찾지 못하면 비슷한 제목을 제안하고 false 반환)
+    bool addRecipe(const RecipeDatabase &db, const string &recipeName)
     {
-        bool found = false;
-
-        for (const auto &r : db.getRecipes()) // getRecipes()로 모든 레시피 접근
+        // 제목 해시 색인으로 바로 찾습니다. (같은 제목이 여러 개면 목록에서 가장 앞의 레시피)
+        RecipeHandle handle = db.findHandleByTitle(recipeName);
+        if (handle.valid())
         {
-            if (r.getTitle() == recipeName)
-            {
-                recipes.push_back(r);
-                cout << r.getTitle() << " added to " << mealType << " (" << servings << " servings)" << endl;
-                found = true;
-                break;
-            }
+            this->db = &db;
+            recipes.push_back(handle);
+            cout << db.resolve(handle)->getTitle() << " added to " << mealType << " (" << servings << " servings)" << endl;
+            return true;
         }
-
-        if (!found)
+        cout << " Recipe not found in database: " << recipeName << endl;
+        // 오타일 수 있으므로 편집 거리가 가까운 제목을 제안
+        vector<string> suggestions = db.suggestTitles(recipeName);
+        if (!suggestions.empty())
         {
-            cout << " Recipe not found in database: " << recipeName << endl;
+            cout << " Did you mean: ";
+            for (size_t i = 0; i < suggestions.size(); i++)
+                cout << (i ? ", " : "") << "'" << suggestions[i] << "'";
+            cout << "?" << endl;
         }
+        return false;
     }
 
     // 레시피 삭제(해당 끼니의 메뉴 수정을 위해)
@@ -62,7 +70,8 @@ class Meal {
     {
         for (auto it = recipes.begin(); it != recipes.end(); ++it)
         {
-            if (it->getTitle() == recipeName)
+            const Recipe *r = db->resolve(*it);
+            if (r != nullptr && r->getTitle() == recipeName)
             {
                 cout << recipeName << "' removed from " << mealType << endl;
                 recipes.erase(it);
@@ -98,11 +107,11 @@ class Meal {
         }
         else
         {
-            for(const auto& r : recipes)
+            forEachRecipe([](const Recipe &r)
             {
                 cout << "--------------------\n";
                 r.display(); // Recipe.h의 display() 호출 (세부정보 표시)
-            }
+            });
         }
     }
 
@@ -116,11 +125,11 @@ class Meal {
         }
         else
         {
-            for(const auto& r : recipes)
+            forEachRecipe([](const Recipe &r)
             {
                 //   - 김치찌개
                 cout << "  - " << r.getTitle() << endl;
-            }
+            });
         }
     }
 
@@ -132,18 +141,30 @@ class Meal {
     vector<string> getRecipeTitles() const
     {
         vector<string> names;
-        for (const auto &r : recipes)
+        forEachRecipe([&](const Recipe &r)
         {
-            names.push_back(r.getTitle());
-        }
+            names.emplace_back(r.getTitle());
+        });
         return names;
     }
 
-    // PlanManager 연동용 — Meal 내 전체 Recipe 반환
-    const vector<Recipe> &getRecipes() const
+    // PlanManager 연동용 — Meal 내 레시피 핸들 반환
+    const vector<RecipeHandle> &getRecipeHandles() const
     {
         return recipes;
     }
+
+    // 아직 데이터베이스에 있는 레시피마다 visit(const Recipe&)를 추가한 순서대로 호출합니다. (삭제된 레시피는 건너뜀)
+    template <typename Visitor>
+    void forEachRecipe(Visitor visit) const
+    {
+        for (RecipeHandle handle : recipes)
+        {
+            const Recipe *r = db->resolve(handle);
+            if (r != nullptr)
+                visit(*r);
+        }
+    }
 };
 
 
@@ -0,0 +1,167 @@
+#ifndef MEAL_CALENDAR_H
+#define MEAL_CALENDAR_H
+
+#include <algorithm> // std::move_backward
+#include <cstdint> // int32_t, INT32_MIN, INT32_MAX
+#include <memory>  // std::unique_ptr: 페이지 소유
+#include <vector>
+#include "Meal.h"
+
+using namespace std;
+
+/**
+ * MealCalendar 클래스
+ * --------------------------
+ * 날짜 번호(Date::toEpochDay, 1970-01-01 == 0)별 끼니 목록을 저장하는 달력.
+ * - 날짜는 64일짜리 페이지로 나누어, 페이지 번호 -> 페이지 포인터 배열(pages)로 찾습니다.
+ *   하루를 찾는 비용은 나눗셈(시프트) 한 번과 배열 접근 두 번이고, 문자열을 만들거나 비교하지 않습니다.
+ * - 한 페이지 안의 날은 연속한 배열이므로, 기간을 날짜 순서대로 훑는 것은 배열을 순서대로 읽는 것과 같습니다.
+ * - 계획이 없는 기간의 페이지는 만들지 않으므로(빈 포인터), 멀리 떨어진 날짜 몇 개만 있어도 메모리는 페이지 몇 개입니다.
+ *
+ * 끼니가 하나도 없는 날은 "계획 없음"으로 봅니다.
+ * 끼니 목록에 끼니를 넣고 빼는 것은 add/erase로만 하므로, 계획이 있는 날 수(plannedDays)를 그때그때 세어 두어 O(1)에 답합니다.
+ */
+class MealCalendar
+{
+private:
+    static constexpr int kPageShift = 6; // 페이지당 64일
+    static constexpr int kPageDays = 1 << kPageShift;
+
+    struct Page
+    {
+        vector<Meal> days[kPageDays];
+    };
+
+    vector<unique_ptr<Page>> pages; // pages[i]는 페이지 번호 firstPage + i
+    int32_t firstPage = 0;
+    size_t dayCount = 0; // 끼니가 하나 이상 있는 날 수
+
+    // 음수 날짜 번호도 내림으로 나누기 위해 산술 시프트 사용
+    static int32_t pageOf(int32_t day) { return day >> kPageShift; }
+    static int slotOf(int32_t day) { return day & (kPageDays - 1); }
+
+    const Page *findPage(int32_t day) const
+    {
+        int64_t index = static_cast<int64_t>(pageOf(day)) - firstPage;
+        if (index < 0 || index >= static_cast<int64_t>(pages.size()))
+            return nullptr;
+        return pages[static_cast<size_t>(index)].get();
+    }
+
+    /*
+     * vector<Meal>& slotAt(int32_t day): day의 끼니 목록을 반환합니다. 그 날이 속한 페이지가 없으면 만듭니다.
+     * details: 기존 범위 앞쪽 날짜면 페이지 포인터 배열의 앞에 빈 자리를 넣습니다. (포인터만 옮김, 끼니는 옮기지 않음)
+     */
+    vector<Meal> &slotAt(int32_t day)
+    {
+        int32_t page = pageOf(day);
+        if (pages.empty())
+        {
+            firstPage = page;
+        }
+        else if (page < firstPage)
+        {
+            size_t shift = static_cast<size_t>(firstPage - page);
+            size_t oldSize = pages.size();
+            pages.resize(oldSize + shift);
+            move_backward(pages.begin(), pages.begin() + oldSize, pages.end()); // 옮긴 자리는 빈 포인터가 됨
+            firstPage = page;
+        }
+        size_t index = static_cast<size_t>(page - firstPage);
+        if (index >= pages.size())
+            pages.resize(index + 1);
+        if (!pages[index])
+            pages[index] = make_unique<Page>();
+        return pages[index]->days[slotOf(day)];
+    }
+
+public:
+    MealCalendar() = default;
+    MealCalendar(const MealCalendar &) = delete;
+    MealCalendar &operator=(const MealCalendar &) = delete;
+
+    void clear()
+    {
+        pages.clear();
+        firstPage = 0;
+        dayCount = 0;
+    }
+
+    // day의 끼니 목록, 페이지가 없으면 nullptr (빈 목록일 수 있음)
+    // 수정용 포인터로는 이미 있는 끼니의 내용만 바꿉니다. 끼니를 넣고 빼는 것은 add/erase로 합니다.
+    const vector<Meal> *find(int32_t day) const
+    {
+        const Page *page = findPage(day);
+        return page ? &page->days[slotOf(day)] : nullptr;
+    }
+    vector<Meal> *find(int32_t day)
+    {
+        return const_cast<vector<Meal> *>(static_cast<const MealCalendar *>(this)->find(day));
+    }
+
+    // day에 끼니 하나를 덧붙입니다. 그 날의 첫 끼니면 계획이 있는 날 수가 늘어납니다.
+    void add(int32_t day, Meal meal)
+    {
+        vector<Meal> &meals = slotAt(day);
+        if (meals.empty())
+            dayCount++;
+        meals.push_back(std::move(meal));
+    }
+
+    // day의 끼니를 모두 지웁니다. 지울 끼니가 있었으면 true
+    bool erase(int32_t day)
+    {
+        vector<Meal> *meals = find(day);
+        if (meals == nullptr || meals->empty())
+            return false;
+        meals->clear();
+        meals->shrink_to_fit();
+        dayCount--;
+        return true;
+    }
+
+    /*
+     * void forEachDay(int32_t firstDay, int32_t lastDay, Visitor visit) const:
+     * [firstDay, lastDay] 기간에서 끼니가 있는 날마다 visit(day, 끼니 목록)을 날짜 순서대로 호출합니다.
+     * details: 없는 페이지는 통째로 건너뜁니다.
+     */
+    template <typename Visitor>
+    void forEachDay(int32_t firstDay, int32_t lastDay, Visitor visit) const
+    {
+        if (pages.empty() || firstDay > lastDay)
+            return;
+        int64_t lowest = static_cast<int64_t>(firstPage) << kPageShift;
+        int64_t highest = ((static_cast<int64_t>(firstPage) + static_cast<int64_t>(pages.size())) << kPageShift) - 1;
+        int64_t from = firstDay > lowest ? firstDay : lowest;
+        int64_t to = lastDay < highest ? lastDay : highest;
+        for (int64_t day = from; day <= to;)
+        {
+            const Page *page = pages[static_cast<size_t>((day >> kPageShift) - firstPage)].get();
+            int64_t pageEnd = ((day >> kPageShift) + 1) << kPageShift; // 다음 페이지 첫 날
+            if (page != nullptr)
+            {
+                for (int64_t d = day; d < pageEnd && d <= to; d++)
+                {
+                    const vector<Meal> &meals = page->days[static_cast<int>(d & (kPageDays - 1))];
+                    if (!meals.empty())
+                        visit(static_cast<int32_t>(d), meals);
+                }
+            }
+            day = pageEnd;
+        }
+    }
+
+    // 끼니가 있는 모든 날마다 visit(day, 끼니 목록)을 날짜 순서대로 호출합니다.
+    template <typename Visitor>
+    void forEachDay(Visitor visit) const
+    {
+        forEachDay(INT32_MIN, INT32_MAX, visit);
+    }
+
+    // 끼니가 하나 이상 있는 날 수 O(1)
+    size_t plannedDays() const { return dayCount; }
+
+    bool empty() const { return dayCount == 0; }
+};
+
+#endif // MEAL_CALENDAR_H
@@ -0,0 +1,225 @@
+#ifndef PANTRY_INDEX_H
+#define PANTRY_INDEX_H
+
+#include <algorithm>   // std::sort, std::stable_sort
+#include <cstdint>     // uint32_t, uint64_t
+#include <memory>      // std::unique_ptr: 재료 이름 표 소유
+#include <string>
+#include <string_view>
+#include <vector>
+#include "BitOps.h" // popcount, lowestBit
+#include "Recipe.h"
+#include "SymbolTable.h" // 소문자 재료 이름 -> 재료 번호
+
+using namespace std;
+
+// 가진 재료로 만들 수 있는 레시피 하나: 행 번호와 부족한 재료 수
+struct PantryMatch
+{
+    uint32_t row;
+    uint32_t missing;
+};
+
+/**
+ * PantryIndex 클래스
+ * --------------------------
+ * "가진 재료로 만들 수 있는 레시피" 질의용 색인. 레시피마다 재료 집합을 비트 집합으로 들고 있습니다.
+ * - 재료 이름은 대소문자 구분 없이(Recipe::foldKey) 같은 재료로 보고, 서로 다른 이름마다 비트 번호를 하나씩 줍니다.
+ *   많이 쓰이는 재료일수록 작은 번호를 주므로, 대부분의 레시피는 재료가 64비트 워드 한두 개에 모입니다.
+ * - 레시피 하나의 재료 집합은 (워드 번호, 64비트 마스크) 쌍의 목록으로 저장합니다. (0인 워드는 저장하지 않음)
+ *
+ * 질의할 때는 가진 재료로 같은 번호 체계의 비트 집합(Pantry)을 만들고, 레시피의 워드마다
+ * popcount(마스크 & ~가진 재료)를 더해 부족한 재료 수를 셉니다. 문자열 비교는 가진 재료 이름을 찾을 때만 일어납니다.
+ * 행 번호는 RecipeDatabase의 recipes[i]와 같습니다. 원본이 바뀌면 rebuild()로 다시 만들어야 합니다.
+ */
+class PantryIndex
+{
+private:
+    unique_ptr<SymbolTable> names = make_unique<SymbolTable>(); // 소문자 재료 이름 -> 이름 번호 (처음 본 순서)
+    vector<uint32_t> bitOfName;       // 이름 번호 -> 비트 번호 (많이 쓰이는 순)
+    vector<string> displayNames;      // 비트 번호 -> 처음 본 원래 철자
+    vector<uint32_t> rowOffsets;      // 크기 n + 1, words/masks 구간
+    vector<uint32_t> words;           // 워드 번호
+    vector<uint64_t> masks;           // 그 워드에서 레시피가 쓰는 재료 비트
+
+public:
+    /*
+     * Pantry: 가진 재료의 비트 집합. PantryIndex::makePantry로 만들며, 그 색인이 다시 만들어지기 전까지만 유효합니다.
+     */
+    class Pantry
+    {
+    private:
+        friend class PantryIndex;
+        vector<uint64_t> bits;
+        size_t unknown = 0; // 어떤 레시피에도 나오지 않는 입력 수
+
+    public:
+        // 입력한 재료 이름 중 어떤 레시피에도 나오지 않아 무시한 것의 수
+        size_t unknownCount() const { return unknown; }
+        bool has(uint32_t bit) const { return (bits[bit >> 6] >> (bit & 63)) & 1; }
+    };
+
+    /*
+     * void rebuild(const vector<Recipe> &recipes): 레시피 목록으로 색인을 다시 만듭니다.
+     * details: 한 번 훑어 재료 이름마다 번호와 쓰는 레시피 수를 세고, 많이 쓰이는 순서로 비트 번호를 정한 뒤
+     *          다시 훑어 레시피별 (워드, 마스크) 목록을 만듭니다. 같은 심볼 id는 한 번만 소문자로 바꿉니다.
+     */
+    void rebuild(const vector<Recipe> &recipes)
+    {
+        names = make_unique<SymbolTable>();
+        displayNames.clear();
+        rowOffsets.clear();
+        words.clear();
+        masks.clear();
+
+        // 1. 재료 심볼 id -> 이름 번호 (레시피들은 보통 데이터베이스의 표 하나를 함께 씀)
+        const SymbolTable *memoTable = nullptr;
+        vector<uint32_t> nameOfSymbol; // 심볼 id -> 이름 번호 + 1 (0이면 아직 모름)
+        vector<uint32_t> recipeNames;  // 레시피마다 이름 번호를 이어 붙임 (rowOffsets 구간)
+        vector<uint32_t> useCount;     // 이름 번호 -> 쓰는 재료 항목 수
+        vector<string> firstSpelling;
+        rowOffsets.reserve(recipes.size() + 1);
+        rowOffsets.push_back(0);
+        for (const auto &recipe : recipes)
+        {
+            const SymbolTable *table = recipe.getSymbols().get();
+            if (table != memoTable)
+            {
+                memoTable = table;
+                nameOfSymbol.assign(table->size(), 0);
+            }
+            for (const auto &ing : recipe.getIngredient())
+            {
+                if (ing.nameId >= nameOfSymbol.size())
+                    nameOfSymbol.resize(ing.nameId + 1, 0);
+                uint32_t &memo = nameOfSymbol[ing.nameId];
+                if (memo == 0)
+                {
+                    const string &name = recipe.ingredientName(ing);
+                    uint32_t id = names->intern(Recipe::foldKey(name));
+                    if (id == firstSpelling.size())
+                    {
+                        firstSpelling.push_back(name);
+                        useCount.push_back(0);
+                    }
+                    memo = id + 1;
+                }
+                recipeNames.push_back(memo - 1);
+                useCount[memo - 1]++;
+            }
+            rowOffsets.push_back(static_cast<uint32_t>(recipeNames.size()));
+        }
+
+        // 2. 많이 쓰이는 이름부터 비트 번호를 줌 (같으면 처음 본 순서)
+        vector<uint32_t> order(useCount.size());
+        for (uint32_t i = 0; i < order.size(); i++)
+            order[i] = i;
+        stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return useCount[a] > useCount[b]; });
+        bitOfName.assign(order.size(), 0);
+        displayNames.resize(order.size());
+        for (uint32_t bit = 0; bit < order.size(); bit++)
+        {
+            bitOfName[order[bit]] = bit;
+            displayNames[bit] = std::move(firstSpelling[order[bit]]);
+        }
+
+        // 3. 레시피마다 비트 번호를 정렬해 (워드, 마스크) 쌍으로 묶음. rowOffsets를 이 목록의 구간으로 다시 씀
+        words.reserve(recipes.size() * 2);
+        masks.reserve(recipes.size() * 2);
+        vector<uint32_t> bits;
+        uint32_t start = 0;
+        for (size_t row = 0; row < recipes.size(); row++)
+        {
+            uint32_t end = rowOffsets[row + 1];
+            bits.clear();
+            for (uint32_t k = start; k < end; k++)
+                bits.push_back(bitOfName[recipeNames[k]]);
+            sort(bits.begin(), bits.end());
+            for (uint32_t bit : bits)
+            {
+                uint32_t word = bit >> 6;
+                if (words.size() == rowOffsets[row] || words.back() != word)
+                {
+                    words.push_back(word);
+                    masks.push_back(0);
+                }
+                masks.back() |= uint64_t(1) << (bit & 63);
+            }
+            start = end;
+            rowOffsets[row + 1] = static_cast<uint32_t>(words.size());
+        }
+    }
+
+    // 색인에 있는 서로 다른 재료 이름 수
+    size_t ingredientCount() const { return displayNames.size(); }
+
+    /*
+     * Pantry makePantry(const vector<string> &onHand) const: 가진 재료 이름 목록으로 비트 집합을 만듭니다.
+     * details: 이름은 대소문자를 구분하지 않고 정확히 같아야 합니다. 어떤 레시피에도 없는 이름은 무시합니다.
+     */
+    Pantry makePantry(const vector<string> &onHand) const
+    {
+        Pantry pantry;
+        pantry.bits.assign((displayNames.size() + 63) / 64, 0);
+        for (const string &name : onHand)
+        {
+            uint32_t id;
+            if (!names->find(Recipe::foldKey(name), id))
+            {
+                pantry.unknown++;
+                continue;
+            }
+            uint32_t bit = bitOfName[id];
+            pantry.bits[bit >> 6] |= uint64_t(1) << (bit & 63);
+        }
+        return pantry;
+    }
+
+    /*
+     * uint32_t missingCount(uint32_t row, const Pantry &pantry, uint32_t limit) const: row의 재료 중 pantry에 없는 재료 수
+     * details: limit을 넘는 순간 더 세지 않고 limit + 1을 반환합니다.
+     */
+    uint32_t missingCount(uint32_t row, const Pantry &pantry, uint32_t limit) const
+    {
+        uint32_t missing = 0;
+        for (uint32_t k = rowOffsets[row]; k < rowOffsets[row + 1]; k++)
+        {
+            missing += BitOps::popcount(masks[k] & ~pantry.bits[words[k]]);
+            if (missing > limit)
+                return limit + 1;
+        }
+        return missing;
+    }
+
+    /*
+     * void forEachCookable(const Pantry &pantry, uint32_t maxMissing, Visitor visit) const:
+     * 부족한 재료가 maxMissing개 이하인 레시피마다 visit(row, missing)을 행 번호 순서로 호출합니다.
+     * details: 재료가 하나도 없는 레시피는 판단할 근거가 없으므로 건너뜁니다.
+     */
+    template <typename Visitor>
+    void forEachCookable(const Pantry &pantry, uint32_t maxMissing, Visitor visit) const
+    {
+        uint32_t rowCount = rowOffsets.empty() ? 0 : static_cast<uint32_t>(rowOffsets.size() - 1);
+        for (uint32_t row = 0; row < rowCount; row++)
+        {
+            if (rowOffsets[row] == rowOffsets[row + 1])
+                continue;
+            uint32_t missing = missingCount(row, pantry, maxMissing);
+            if (missing <= maxMissing)
+                visit(row, missing);
+        }
+    }
+
+    // row의 재료 중 pantry에 없는 재료마다 visit(이름)을 호출합니다. (처음 본 원래 철자)
+    template <typename Visitor>
+    void forEachMissing(uint32_t row, const Pantry &pantry, Visitor visit) const
+    {
+        for (uint32_t k = rowOffsets[row]; k < rowOffsets[row + 1]; k++)
+        {
+            for (uint64_t bits = masks[k] & ~pantry.bits[words[k]]; bits; bits &= bits - 1)
+                visit(string_view(displayNames[words[k] * 64 + BitOps::lowestBit(bits)]));
+        }
+    }
+};
+
+#endif // PANTRY_INDEX_H
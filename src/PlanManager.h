@@ -5,8 +5,10 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <tuple> // std::tuple: 장보기 목록을 정수 키로 합산
 #include "Date.h"
 #include "Meal.h"
+#include "MealCalendar.h" // 날짜 번호 -> 끼니 목록 (페이지 단위 달력)
 #include "RecipeDatabase.h"
 #include "Recipe.h"
 #include <iomanip> // 1. <iomanip> 헤더를 추가 10-05 pm10:45
@@ -36,9 +38,10 @@ using namespace std;
 class PlanManager
 {
 private:
-    // 날짜를 키로, 그 날의 모든 Meal 정보를 값으로 저장
-    // 예: "2024-10-05" -> [아침Meal, 점심Meal, 저녁Meal]
-    map<string, vector<Meal>> mealPlan;
+    // 날짜 번호(Date::toEpochDay)를 키로, 그 날의 모든 Meal 정보를 값으로 저장
+    // 예: 2024-10-05 (20001) -> [아침Meal, 점심Meal, 저녁Meal]
+    // "YYYY-MM-DD" 문자열을 받는 함수들은 parseDateKey로 날짜 번호로 바꿔 같은 달력을 씁니다.
+    MealCalendar mealPlan;
 
     // 계획 기간 (시작일과 종료일)
     Date startDate;
@@ -89,7 +92,19 @@ public:
     ~PlanManager()
     {
         cout << "PlanManager destroyed. Total planned days: "
-             << mealPlan.size() << endl;
+             << mealPlan.plannedDays() << endl;
+    }
+
+    /**
+     * "YYYY-MM-DD" 문자열 -> 날짜 번호 (문자열 API용 어댑터)
+     * 형식이 틀리거나 달력에 없는 날짜면 메시지를 출력하고 false
+     */
+    static bool parseDateKey(const string &dateStr, int &day)
+    {
+        if (Date::parseDay(dateStr, day))
+            return true;
+        cout << "❌ Invalid date '" << dateStr << "' (expected YYYY-MM-DD)" << endl;
+        return false;
     }
 
     // ==================== 유틸리티 함수 ====================
@@ -208,9 +223,16 @@ public:
      */
     void addMealToDate(const string &dateStr, const Meal &meal)
     {
-        mealPlan[dateStr].push_back(meal);
+        int day;
+        if (parseDateKey(dateStr, day))
+            addMealToDate(day, meal);
+    }
+
+    void addMealToDate(int day, const Meal &meal)
+    {
+        mealPlan.add(day, meal);
 
-        cout << "Meal added to " << dateStr << ":" << endl;
+        cout << "Meal added to " << Date::formatDay(day) << ":" << endl;
         cout << "  - Type: " << meal.getMealType() << endl;
         cout << "  - Servings: " << meal.getServings() << endl;
 
@@ -242,6 +264,16 @@ public:
                          const string &mealType,
                          const string &recipeName,
                          int servings = 1)
+    {
+        int day;
+        if (parseDateKey(dateStr, day))
+            addRecipeToMeal(day, mealType, recipeName, servings);
+    }
+
+    void addRecipeToMeal(int day,
+                         const string &mealType,
+                         const string &recipeName,
+                         int servings = 1)
     {
         if (recipeDB == nullptr)
         {
@@ -250,15 +282,17 @@ public:
         }
 
         bool found = false;
+        bool added = false;
+        string dateStr = Date::formatDay(day); // 메시지 출력용
 
         // 1. 이미 존재하는 Meal에 레시피 추가 시도
-        if (mealPlan.find(dateStr) != mealPlan.end())
+        if (vector<Meal> *meals = mealPlan.find(day))
         {
-            for (Meal &meal : mealPlan[dateStr])
+            for (Meal &meal : *meals)
             {
                 if (meal.getMealType() == mealType)
                 {
-                    meal.addRecipe(*recipeDB, recipeName);
+                    added = meal.addRecipe(*recipeDB, recipeName);
                     found = true;
                     break;
                 }
@@ -270,13 +304,23 @@ public:
         {
             // 새로운 Meal 객체 생성 및 레시피 추가 후 저장
             Meal newMeal(mealType, servings);
-            newMeal.addRecipe(*recipeDB, recipeName);
-            mealPlan[dateStr].push_back(newMeal);
+            added = newMeal.addRecipe(*recipeDB, recipeName);
+            if (!added)
+            {
+                // 레시피를 찾지 못했으면 (제안은 addRecipe가 출력) 빈 끼니를 만들지 않음
+                cout << "❌ Recipe '" << recipeName << "' was not added on " << dateStr << endl;
+                return;
+            }
+            mealPlan.add(day, std::move(newMeal));
 
             // ✅ 상세 피드백: 새로 생성됨
             cout << "✅ New " << mealType << " created and recipe '" << recipeName
                  << "' added on " << dateStr << endl;
         }
+        else if (!added)
+        {
+            cout << "❌ Recipe '" << recipeName << "' was not added on " << dateStr << endl;
+        }
         else
         {
             // ✅ 상세 피드백: 기존 Meal에 추가됨
@@ -297,6 +341,9 @@ public:
             cout << "❌ Error: RecipeDatabase not connected!" << endl;
             return;
         }
+        int day;
+        if (!parseDateKey(dateStr, day))
+            return;
 
         Meal newMeal(mealType, servings);
 
@@ -305,7 +352,7 @@ public:
             newMeal.addRecipe(*recipeDB, recipeName);
         }
 
-        mealPlan[dateStr].push_back(newMeal);
+        mealPlan.add(day, std::move(newMeal));
 
         cout << mealType << " added to " << dateStr << " with "
              << recipeNames.size() << " recipe(s)" << endl;
@@ -316,9 +363,11 @@ public:
      */
     void removeMealsFromDate(const string &dateStr)
     {
-        if (mealPlan.find(dateStr) != mealPlan.end())
+        int day;
+        if (!parseDateKey(dateStr, day))
+            return;
+        if (mealPlan.erase(day))
         {
-            mealPlan.erase(dateStr);
             cout << "All meals removed from " << dateStr << endl;
         }
         else
@@ -362,15 +411,13 @@ public:
         cout << "🔍 Searching recipes with difficulty: "
              << getDifficultyDescription(targetDiff) << "..." << endl;
 
-        // RecipeDatabase에서 모든 레시피 가져와서 필터링
-        const vector<Recipe> &allRecipes = recipeDB->getRecipes();
-
-        for (const Recipe &recipe : allRecipes)
+        // RecipeDatabase가 미리 나눠 둔 난이도별 목록에서 바로 꺼냄 (전체 레시피를 훑지 않음), 목록 순서로 정렬
+        const RecipeColumns &columns = recipeDB->getColumns();
+        vector<uint32_t> rows = recipeDB->getRowsByDifficulty(targetDiff).sortedRows();
+        recommendations.reserve(rows.size());
+        for (uint32_t row : rows)
         {
-            if (recipe.getDifficulty() == targetDiff)
-            {
-                recommendations.push_back(recipe.getTitle());
-            }
+            recommendations.emplace_back(columns.titleAt(row));
         }
 
         if (recommendations.empty())
@@ -411,34 +458,19 @@ public:
             return;
         }
 
-        // 1. 난이도별로 레시피 목록을 미리 분류합니다. (사용자 제약 조건 반영)
-        vector<Recipe> easyRecipes, mediumRecipes, hardRecipes;
-        for (const auto &recipe : recipeDB->getRecipes())
+        // 1. 각 끼니에 사용할 수 있는 레시피 목록(행 번호)을 준비합니다. (사용자 제약 조건 반영)
+        //    RecipeDatabase의 난이도별 목록을 이어 붙인 뷰만 만들고, 레시피 id는 복사하지 않습니다.
+        const vector<Recipe> &recipes = recipeDB->getRecipes();
+        DifficultyRows breakfastPool, lunchPool, dinnerPool;
+        breakfastPool.append(recipeDB->getRowsByDifficulty(Difficulty::C));
+        lunchPool.append(recipeDB->getRowsByDifficulty(Difficulty::C));
+        if (maxDifficultyLevel != Difficulty::C)
         {
-            switch (recipe.getDifficulty())
-            {
-            case Difficulty::C:
-                easyRecipes.push_back(recipe);
-                break;
-            case Difficulty::B:
-                if (maxDifficultyLevel != Difficulty::C)
-                    mediumRecipes.push_back(recipe);
-                break;
-            case Difficulty::A:
-                if (maxDifficultyLevel == Difficulty::A)
-                    hardRecipes.push_back(recipe);
-                break;
-            }
+            lunchPool.append(recipeDB->getRowsByDifficulty(Difficulty::B));
+            dinnerPool.append(recipeDB->getRowsByDifficulty(Difficulty::B));
         }
-
-        // 각 끼니에 사용할 수 있는 레시피 목록 준비
-        vector<Recipe> breakfastPool = easyRecipes;
-        vector<Recipe> lunchPool;
-        lunchPool.insert(lunchPool.end(), easyRecipes.begin(), easyRecipes.end());
-        lunchPool.insert(lunchPool.end(), mediumRecipes.begin(), mediumRecipes.end());
-        vector<Recipe> dinnerPool;
-        dinnerPool.insert(dinnerPool.end(), mediumRecipes.begin(), mediumRecipes.end());
-        dinnerPool.insert(dinnerPool.end(), hardRecipes.begin(), hardRecipes.end());
+        if (maxDifficultyLevel == Difficulty::A)
+            dinnerPool.append(recipeDB->getRowsByDifficulty(Difficulty::A));
 
         // 2. 레시피가 충분한지 확인합니다.
         if (breakfastPool.empty() || lunchPool.empty() || dinnerPool.empty())
@@ -460,32 +492,30 @@ public:
         cout << "   (All within your constraint: " << getDifficultyDescription(maxDifficultyLevel) << ")\n"
              << endl;
 
-        // 3. 시작일부터 종료일까지 하루씩 반복하며 계획 생성
+        // 3. 시작일부터 종료일까지 날짜 번호를 하루씩 늘리며 계획 생성 (날짜는 스택 버퍼에 써서 출력, 문자열 할당 없음)
         srand(time(0)); // 매번 다른 결과를 위해 난수 시드 초기화
-        Date currentDate = startDate;
-        while (currentDate <= endDate)
+        CompactDate last = endDate.getCompact();
+        char dayText[CompactDate::kFormatSize];
+        for (CompactDate date = startDate.getCompact(); date.day <= last.day; date = date.plusDays(1))
         {
-            string dateStr = currentDate.toString().substr(0, 10); // "YYYY-MM-DD" 부분만 추출
-
-            cout << "🗓️ Generating plan for " << dateStr << "..." << endl;
+            int day = date.day;
+            date.format(dayText, sizeof(dayText), false);
+            cout << "🗓️ Generating plan for " << dayText << "..." << endl;
 
             // 해당 날짜의 기존 계획을 초기화
-            mealPlan[dateStr].clear();
+            mealPlan.erase(day);
 
             // 아침: 쉬움(C) 레시피 중 무작위 선택
-            string breakfastRecipe = breakfastPool[rand() % breakfastPool.size()].getTitle();
-            addRecipeToMeal(dateStr, "Breakfast", breakfastRecipe, 1);
+            string breakfastRecipe(recipes[breakfastPool[rand() % breakfastPool.size()]].getTitle());
+            addRecipeToMeal(day, "Breakfast", breakfastRecipe, 1);
 
             // 점심: 쉬움(C) 또는 보통(B) 레시피 중 무작위 선택
-            string lunchRecipe = lunchPool[rand() % lunchPool.size()].getTitle();
-            addRecipeToMeal(dateStr, "Lunch", lunchRecipe, 1);
+            string lunchRecipe(recipes[lunchPool[rand() % lunchPool.size()]].getTitle());
+            addRecipeToMeal(day, "Lunch", lunchRecipe, 1);
 
             // 저녁: 보통(B) 또는 어려움(A) 레시피 중 무작위 선택
-            string dinnerRecipe = dinnerPool[rand() % dinnerPool.size()].getTitle();
-            addRecipeToMeal(dateStr, "Dinner", dinnerRecipe, 1);
-
-            // 다음 날짜로 이동
-            currentDate.incrementDay();
+            string dinnerRecipe(recipes[dinnerPool[rand() % dinnerPool.size()]].getTitle());
+            addRecipeToMeal(day, "Dinner", dinnerRecipe, 1);
         }
 
         cout << "\n✅ Balanced meal plan generated successfully!" << endl;
@@ -498,16 +528,19 @@ public:
      */
     void viewPlanForDate(const string &dateStr) const
     {
-        auto it = mealPlan.find(dateStr);
+        int day;
+        if (!parseDateKey(dateStr, day))
+            return;
+        const vector<Meal> *meals = mealPlan.find(day);
 
-        if (it == mealPlan.end() || it->second.empty())
+        if (meals == nullptr || meals->empty())
         {
             cout << "No meal plan found for " << dateStr << endl;
             return;
         }
 
         cout << "\n===== Meal Plan for " << dateStr << " =====" << endl;
-        for (const Meal &meal : it->second)
+        for (const Meal &meal : *meals)
         {
             cout << "\n[" << meal.getMealType() << "]" << endl;
             meal.display();
@@ -521,20 +554,21 @@ public:
         cout << "\n===== Full Plan Summary (Meals + Schedules) =====" << endl;
 
         // 식사 계획 출력
-        if (mealPlan.empty())
+        size_t plannedDays = mealPlan.plannedDays();
+        if (plannedDays == 0)
         {
             cout << "📅 Meal Plans: None created yet." << endl;
         }
         else
         {
-            cout << "📅 Meal Plans: " << mealPlan.size() << " days planned" << endl;
+            cout << "📅 Meal Plans: " << plannedDays << " days planned" << endl;
             cout << "Difficulty constraint: " << getDifficultyDescription(maxDifficultyLevel) << endl;
 
-            for (const auto &dayPlan : mealPlan)
+            mealPlan.forEachDay([](int day, const vector<Meal> &meals)
             {
-                cout << "   🍽️  " << dayPlan.first << " - "
-                     << dayPlan.second.size() << " meal(s)" << endl;
-            }
+                cout << "   🍽️  " << Date::formatDay(day) << " - "
+                     << meals.size() << " meal(s)" << endl;
+            });
         }
 
         // 공유 스케줄 출력
@@ -561,14 +595,17 @@ public:
      */
     void viewIntegratedPlanForDate(const string &dateStr) const
     {
+        int day;
+        if (!parseDateKey(dateStr, day))
+            return;
         cout << "\n===== Integrated Plan for " << dateStr << " =====" << endl;
 
         // 1. 식사 계획 출력
-        auto mealIt = mealPlan.find(dateStr);
-        if (mealIt != mealPlan.end() && !mealIt->second.empty())
+        const vector<Meal> *meals = mealPlan.find(day);
+        if (meals != nullptr && !meals->empty())
         {
             cout << "\n🍽️  Meal Plans:" << endl;
-            for (const Meal &meal : mealIt->second)
+            for (const Meal &meal : *meals)
             {
                 cout << "\n[" << meal.getMealType() << "]" << endl;
                 meal.display();
@@ -587,8 +624,7 @@ public:
 
             for (const Date &schedule : *sharedSchedules)
             {
-                string scheduleDate = schedule.toString().substr(0, 10); // YYYY-MM-DD 부분만 추출
-                if (scheduleDate == dateStr)
+                if (schedule.getCompact().day == day) // 문자열을 만들지 않고 날짜 번호로 비교
                 {
                     cout << "   📅 " << schedule.toString() << endl;
                     foundSchedules = true;
@@ -611,7 +647,7 @@ public:
     /**
      * ✅ 전체 계획의 모든 재료를 통합한 장보기 목록 생성
      *
-     * Meal이 Recipe 객체를 직접 가지고 있으므로 구현 간단해짐!
+     * Meal은 레시피 핸들만 가지고 있으므로, 레시피는 RecipeDatabase에서 찾아 재료를 읽습니다. (삭제된 레시피는 건너뜀)
      */
     vector<string> generateShoppingList() const
     {
@@ -619,22 +655,21 @@ public:
 
         cout << "\n===== Generating Shopping List =====" << endl;
 
-        if (mealPlan.empty())
+        if (mealPlan.plannedDays() == 0)
         {
             cout << "No meals planned. Shopping list is empty." << endl;
             return shoppingList;
         }
 
         // 재료와 수량을 저장할 맵
+        // 먼저 (심볼 표, 재료 id, 단위 id) 정수 키로 합산하고, 문자열 키는 마지막에 한 번만 만듭니다.
+        map<tuple<const SymbolTable *, uint32_t, uint32_t>, double> ingredientTotals;
         map<string, double> ingredientCount; // 재료명 -> 개수
 
-        // Step 1: 모든 날짜 순회
-        for (const auto &dayPlan : mealPlan)
+        // Step 1: 모든 날짜 순회 (날짜 순서대로 달력 페이지를 읽음)
+        mealPlan.forEachDay([&](int day, const vector<Meal> &mealsOfDay)
         {
-            const string &dateStr = dayPlan.first;
-            const vector<Meal> &mealsOfDay = dayPlan.second;
-
-            cout << "📅 Processing " << dateStr << " ("
+            cout << "📅 Processing " << Date::formatDay(day) << " ("
                  << mealsOfDay.size() << " meal(s))..." << endl;
 
             // Step 2: 각 Meal 순회
@@ -643,12 +678,11 @@ public:
                 cout << "   🍽️  " << meal.getMealType() << " ("
                      << meal.getServings() << " serving(s))" << endl;
 
-                // Step 3: Meal에서 Recipe 객체들 가져오기
-                const vector<Recipe> &recipes = meal.getRecipes();
+                // Step 3: Meal의 레시피 핸들을 데이터베이스에서 찾음
                 int servings = meal.getServings();
 
                 // Step 4: 각 Recipe에서 재료 추출
-                for (const Recipe &recipe : recipes)
+                meal.forEachRecipe([&](const Recipe &recipe)
                 {
                     cout << "      🔍 Recipe: " << recipe.getTitle() << endl;
 
@@ -663,17 +697,24 @@ public:
                         // 양(quantity)이 0보다 큰 재료만 장보기 목록에 추가
                         if (ingredient.quantity > 0)
                         {
-                            // [수정] '이름 (단위)'를 고유한 Key로 사용합니다.
-                            // 예: "flour (cup)", "egg (ea)"
-                            string key = ingredient.name + " (" + ingredient.unit + ")";
+                            // [수정] (재료, 단위) id 쌍을 고유한 Key로 사용합니다. (문자열 비교 없음)
+                            auto key = make_tuple(recipe.getSymbols().get(), ingredient.nameId, ingredient.unitId);
 
                             // [수정] '재료의 양 * 인분 수'를 총량에 더해줍니다.
-                            ingredientCount[key] += ingredient.quantity * servings;
+                            ingredientTotals[key] += ingredient.quantity * servings;
                         }
                     }
-                }
+                });
             }
+        });
+        // '이름 (단위)' 문자열 키로 바꿉니다. 예: "flour (cup)", "egg (ea)"
+        for (const auto &total : ingredientTotals)
+        {
+            const SymbolTable &symbols = *get<0>(total.first);
+            string key = symbols.name(get<1>(total.first)) + " (" + symbols.name(get<2>(total.first)) + ")";
+            ingredientCount[key] += total.second;
         }
+
         // ingredient 재료 수를 double 로 바꿔서 소수점 2자리까지만 출력하도록 변경
         // Step 6: map을 vector로 변환
         cout << "\n📋 Consolidating ingredients..." << endl;
@@ -725,7 +766,7 @@ public:
     // ==================== Getter 함수들 ====================
 
     Difficulty getMaxDifficulty() const { return maxDifficultyLevel; }
-    int getPlannedDaysCount() const { return mealPlan.size(); }
+    int getPlannedDaysCount() const { return static_cast<int>(mealPlan.plannedDays()); }
     Date getStartDate() const { return startDate; }
     Date getEndDate() const { return endDate; }
 };
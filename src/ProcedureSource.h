@@ -0,0 +1,106 @@
+#ifndef PROCEDURE_SOURCE_H
+#define PROCEDURE_SOURCE_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "MappedFile.h"
+
+using namespace std;
+
+/**
+ * ProcedureSource 클래스
+ * --------------------------
+ * 조리 절차(procedure)를 필요할 때만 읽어오기 위해, 원본 파일의 매핑을 붙잡고 있는 클래스.
+ * - Recipe는 조리 절차 대신 (이 객체, 파일 안의 위치, 길이)만 들고 있다가 getProcedure()가 처음 호출될 때 텍스트를 만듭니다.
+ * - 여러 Recipe가 shared_ptr로 하나의 ProcedureSource를 공유하며, 마지막 Recipe가 사라지면 매핑도 해제됩니다.
+ *
+ * 원본 종류:
+ * - rawText == true : Recipe.txt의 원본 줄들. 읽을 때 로더와 같은 규칙(줄 단위 trim, 빈 줄 제외)으로 정리합니다.
+ * - rawText == false: 바이너리 스냅샷의 문자열 테이블. 저장된 그대로 사용합니다.
+ *
+ * 주의: 매핑된 파일을 제자리에서 덮어쓰면(truncate) 안 됩니다. 저장은 임시 파일에 쓴 뒤 rename으로 교체합니다.
+ */
+class ProcedureSource
+{
+private:
+    MappedFile file;
+    bool rawText;
+
+    // RecipeDatabase::trim과 같은 규칙 (공백만 있는 줄은 그대로 둠)
+    static string_view trimLine(string_view s)
+    {
+        size_t first = s.find_first_not_of(" \t\n\r");
+        if (first == string_view::npos)
+            return s;
+        size_t last = s.find_last_not_of(" \t\n\r");
+        return s.substr(first, last - first + 1);
+    }
+
+public:
+    ProcedureSource(MappedFile &&mapped, bool isRawText) : file(std::move(mapped)), rawText(isRawText) {}
+
+    string_view view() const { return file.view(); }
+
+    // 로딩이 끝난 뒤 호출: 파싱하면서 읽은 페이지를 내려놓아 상주 메모리를 줄입니다.
+    void dropResidentPages() { file.dropResidentPages(); }
+
+    // --- 조리 절차 텍스트 규칙 (로더의 즉시 읽기 경로와 지연 읽기 경로가 함께 사용) ---
+
+    // 조리 절차 한 줄을 덧붙입니다. (trim된 줄이 비어 있으면 무시)
+    static void appendLine(string &procedure, string_view trimmedLine)
+    {
+        if (!trimmedLine.empty())
+        {
+            procedure.append(trimmedLine);
+            procedure += '\n';
+        }
+    }
+
+    // 완성된 조리 절차의 앞뒤 공백을 제자리에서 제거합니다. (trim(procedure)와 같은 결과)
+    static void finish(string &procedure)
+    {
+        size_t first = procedure.find_first_not_of(" \t\n\r");
+        if (first != string::npos)
+        {
+            procedure.erase(procedure.find_last_not_of(" \t\n\r") + 1);
+            procedure.erase(0, first);
+        }
+    }
+
+    // 원본 줄 구간(raw)을 appendLine 규칙으로 procedure에 덧붙입니다. (finish는 호출하지 않음)
+    static void appendRawLines(string &procedure, string_view raw)
+    {
+        size_t pos = 0;
+        while (pos < raw.size())
+        {
+            size_t end = raw.find('\n', pos);
+            if (end == string_view::npos)
+                end = raw.size();
+            appendLine(procedure, trimLine(raw.substr(pos, end - pos)));
+            pos = end + 1;
+        }
+    }
+
+    /*
+     * string load(uint64_t offset, uint32_t length) const: 파일의 [offset, offset + length) 구간에서 조리 절차 텍스트를 만듭니다.
+     * return 완성된 조리 절차 (구간이 파일 범위를 벗어나면 빈 문자열)
+     */
+    string load(uint64_t offset, uint32_t length) const
+    {
+        string_view data = file.view();
+        if (offset > data.size() || data.size() - offset < length)
+            return string();
+        string_view raw = data.substr(offset, length);
+        if (!rawText)
+            return string(raw);
+
+        string procedure;
+        procedure.reserve(raw.size());
+        appendRawLines(procedure, raw);
+        finish(procedure);
+        return procedure;
+    }
+};
+
+#endif // PROCEDURE_SOURCE_H
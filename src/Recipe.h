@@ -3,8 +3,14 @@
 
 #include <iostream>
 #include <string> // std::string: 문자열을 다루는 클래스를 사용하기 위해 포함
+#include <string_view> // std::string_view: 아레나에 저장된 제목/조리 절차를 복사 없이 반환
 #include <vector>
 #include <iomanip> 
+#include <algorithm> // std::none_of: 제목에 대문자가 있는지 확인
+#include <memory>  // std::shared_ptr: 지연 로딩용 ProcedureSource 공유
+#include "ProcedureSource.h"
+#include "SymbolTable.h" // SymbolTable: 재료 이름/단위를 정수 id로 저장
+#include "TextArena.h"   // TextArena: 제목/조리 절차 문자열을 큰 블록에 모아 저장
 
 /*
 <vector> 헤더를 추가합니다.
@@ -39,10 +45,12 @@ using namespace std;
 
 // 재료 구조체 추가-> 이걸로 인분 계산 가능하게 설정 
 
+// 이름과 단위는 문자열 대신 SymbolTable의 id로 저장합니다. (문자열은 Recipe::ingredientName / ingredientUnit으로 얻음)
+// 같은 표의 id끼리는 정수 비교만으로 같은 재료/단위인지 알 수 있습니다.
 struct Ingredient {
-    string name;
-    double quantity;
-    string unit;
+    uint32_t nameId = 0;
+    uint32_t unitId = 0;
+    double quantity = 0;
 };
 
 enum class Difficulty
@@ -55,26 +63,105 @@ enum class Difficulty
 class Recipe
 {
 private:
-    string title;              // 요리 이름
-    string procedure;          // 조리 방법
+    string_view title;              // 요리 이름 (arena에 저장)
+    string_view titleKey;           // 대소문자 구분 없는 비교용 소문자 제목 (title에 대문자가 없으면 title과 같은 바이트)
+    mutable string_view procedure;  // 조리 방법 (arena에 저장, 지연 로딩 시 처음 읽을 때 채워짐)
     int time;                  // 조리 시간 (분)
     vector<Ingredient> ingredient; // 재료 목록
     Difficulty difficulty;     // 난이도
+    shared_ptr<const SymbolTable> symbols; // 재료 id를 문자열로 바꿀 표 (RecipeDatabase가 소유, 레시피 복사본도 공유)
+    shared_ptr<TextArena> arena;           // title/procedure가 저장된 아레나 (RecipeDatabase가 소유, 레시피 복사본도 공유)
+
+    // 지연 로딩 정보: procedureSource가 있으면 procedure는 아직 읽지 않은 상태이고,
+    // 원본 파일의 [procedureOffset, procedureOffset + procedureLength) 구간에 있습니다.
+    mutable shared_ptr<const ProcedureSource> procedureSource;
+    uint64_t procedureOffset = 0;
+    uint32_t procedureLength = 0;
+
+    // title을 저장하고 소문자 키를 함께 만듭니다. 이미 소문자인 제목은 키로 그대로 사용하므로 추가 공간이 없습니다.
+    void storeTitle(TextArena &target, string_view text)
+    {
+        title = target.store(text);
+        bool folded = none_of(title.begin(), title.end(), [](char c) { return foldChar(c) != c; });
+        titleKey = folded ? title : target.storeTransformed(title, foldChar);
+    }
+    void releaseTitle() const
+    {
+        arena->release(title);
+        if (titleKey.data() != title.data())
+            arena->release(titleKey);
+    }
 
 public:
+    // 검색 키에 쓰는 대소문자 변환 규칙: ASCII 대문자만 소문자로 바꿉니다. (RecipeDatabase::toLower와 같은 결과)
+    static char foldChar(char c)
+    {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+    static string foldKey(string_view text)
+    {
+        string key(text);
+        for (char &c : key)
+            c = foldChar(c);
+        return key;
+    }
+
     // --- 생성자 ---
-    Recipe(const string &title, const string &procedure, int time, const vector<Ingredient> &ingredient, Difficulty difficulty)
-        : title(title), procedure(procedure), time(time), ingredient(ingredient), difficulty(difficulty) {}
+    // title/procedure는 arena에 복사됩니다. (arena가 nullptr이면 이 레시피 전용 아레나를 만듦)
+    // ingredient의 id는 symbols 표의 id여야 합니다.
+    Recipe(string_view title, string_view procedure, int time, vector<Ingredient> ingredient, Difficulty difficulty,
+           shared_ptr<const SymbolTable> symbols, shared_ptr<TextArena> arena)
+        : time(time), ingredient(std::move(ingredient)), difficulty(difficulty), symbols(std::move(symbols)),
+          arena(arena ? std::move(arena) : make_shared<TextArena>())
+    {
+        storeTitle(*this->arena, title);
+        this->procedure = this->arena->store(procedure);
+    }
+
+    // 지연 로딩 생성자: 조리 절차 텍스트 대신 원본 파일 안의 위치만 기억합니다.
+    Recipe(string_view title, shared_ptr<const ProcedureSource> source, uint64_t procedureOffset, uint32_t procedureLength,
+           int time, vector<Ingredient> ingredient, Difficulty difficulty, shared_ptr<const SymbolTable> symbols,
+           shared_ptr<TextArena> arena)
+        : time(time), ingredient(std::move(ingredient)), difficulty(difficulty), symbols(std::move(symbols)),
+          arena(arena ? std::move(arena) : make_shared<TextArena>()),
+          procedureSource(std::move(source)), procedureOffset(procedureOffset), procedureLength(procedureLength)
+    {
+        storeTitle(*this->arena, title);
+    }
 
     // --- Getter 함수들 ---
-    const string &getTitle() const
+    // 반환된 뷰는 이 레시피(또는 같은 아레나를 쓰는 복사본)가 살아있는 동안 유효합니다.
+    string_view getTitle() const
     {
         return title;
     }
-    const string &getProcedure() const
+    // 소문자로 바꾼 제목. 로딩/수정할 때 한 번만 만들어 두므로, 대소문자 구분 없는 비교는 이 키끼리 바로 비교합니다.
+    string_view getTitleKey() const
     {
+        return titleKey;
+    }
+    // 지연 로딩 상태라면 처음 호출될 때 원본 파일에서 읽어 아레나에 보관합니다.
+    string_view getProcedure() const
+    {
+        if (procedureSource)
+        {
+            procedure = arena->store(procedureSource->load(procedureOffset, procedureLength));
+            procedureSource.reset();
+        }
         return procedure;
     }
+    bool isProcedureLoaded() const
+    {
+        return !procedureSource;
+    }
+    // 조리 절차를 out 뒤에 덧붙입니다. 아직 읽지 않은 상태라면 보관(캐시)하지 않고 한 번만 읽습니다. (전체 저장 등 일괄 순회용)
+    void appendProcedureTo(string &out) const
+    {
+        if (procedureSource)
+            out += procedureSource->load(procedureOffset, procedureLength);
+        else
+            out += procedure;
+    }
     int getTime() const
     {
         return time;
@@ -87,16 +174,38 @@ public:
     {
         return difficulty;
     }
+    // 재료 id를 문자열로 바꿉니다. (이 레시피의 재료여야 함)
+    const string &ingredientName(const Ingredient &ing) const
+    {
+        return symbols->name(ing.nameId);
+    }
+    const string &ingredientUnit(const Ingredient &ing) const
+    {
+        return symbols->name(ing.unitId);
+    }
+    const shared_ptr<const SymbolTable> &getSymbols() const
+    {
+        return symbols;
+    }
+    const shared_ptr<TextArena> &getArena() const
+    {
+        return arena;
+    }
     // --------------------
 
     // --- Setter 함수들 ---
-    void setTitle(const string &newTitle)
+    void setTitle(string_view newTitle)
     {
-        this->title = newTitle;
+        releaseTitle(); // 새 제목은 아레나의 다른 위치에 저장되므로, newTitle이 현재 제목을 가리켜도 안전
+        storeTitle(*arena, newTitle);
     }
-    void setProcedure(const string &newProcedure)
+    void setProcedure(string_view newProcedure)
     {
-        this->procedure = newProcedure;
+        string_view stored = arena->store(newProcedure);
+        if (!procedureSource)
+            arena->release(procedure);
+        this->procedure = stored;
+        procedureSource.reset();
     }
     void setTime(int newTime)
     {
@@ -106,6 +215,42 @@ public:
     {
         this->ingredient = newIngredient;
     }
+    /*
+     * void rebindSymbols(shared_ptr<const SymbolTable> table, const vector<uint32_t> &remap): 재료 id를 다른 표의 id로 바꿉니다.
+     * details: 스레드별 임시 표로 파싱한 레시피를 데이터베이스의 표로 옮길 때 사용합니다. remap은 이전 id -> 새 id 변환표입니다.
+     */
+    void rebindSymbols(shared_ptr<const SymbolTable> table, const vector<uint32_t> &remap)
+    {
+        for (auto &ing : ingredient)
+        {
+            ing.nameId = remap[ing.nameId];
+            ing.unitId = remap[ing.unitId];
+        }
+        symbols = std::move(table);
+    }
+
+    // --- 아레나 관리 (RecipeDatabase가 사용) ---
+
+    // 이 레시피의 문자열이 더 이상 쓰이지 않음을 아레나에 알립니다. (삭제/교체 직전에 호출)
+    void releaseText() const
+    {
+        releaseTitle();
+        if (!procedureSource)
+            arena->release(procedure);
+    }
+    // 같은 바이트를 이미 넘겨받은(absorb) 아레나를 가리키도록 바꿉니다. 문자열은 복사하지 않습니다.
+    void rebindArena(shared_ptr<TextArena> target)
+    {
+        arena = std::move(target);
+    }
+    // 문자열을 target 아레나로 복사해 옮깁니다. (압축용) 이전 아레나는 이 레시피를 더 이상 참조하지 않습니다.
+    void moveTextTo(const shared_ptr<TextArena> &target)
+    {
+        storeTitle(*target, title);
+        if (!procedureSource)
+            procedure = target->store(procedure);
+        arena = target;
+    }
     void setDifficulty(Difficulty newDifficulty)
     {
         this->difficulty = newDifficulty;
@@ -137,10 +282,10 @@ public:
         cout << "\nIngredients:" << endl;
         for (const auto& ing : ingredient) {
             if (ing.quantity == 0) {
-                cout << "- " << ing.unit << " of " << ing.name << endl;
+                cout << "- " << ingredientUnit(ing) << " of " << ingredientName(ing) << endl;
             } else {
                 // 2. 소수점 형식을 적용하여 출력 (소수점 2자리) iomanip 사용
-                cout << "- " << fixed << setprecision(2) << ing.quantity << " " << ing.unit << " of " << ing.name << endl;
+                cout << "- " << fixed << setprecision(2) << ing.quantity << " " << ingredientUnit(ing) << " of " << ingredientName(ing) << endl;
                 /*
                 setprecision(n): 실수의 전체 유효 숫자를 n자리로 제한
                 fixed: setprecision의 의미를 소수점 이하 자릿수로 변경
@@ -149,7 +294,7 @@ public:
         }
 
         cout << "\nProcedure:\n"
-             << procedure << endl
+             << getProcedure() << endl
              << endl;
     }
 };
@@ -0,0 +1,344 @@
+#ifndef RECIPE_COLUMNS_H
+#define RECIPE_COLUMNS_H
+
+#include <algorithm>   // std::upper_bound, std::copy
+#include <cstdint>     // uint8_t, uint32_t
+#include <string>
+#include <string_view> // 제목을 복사 없이 돌려주기 위해 포함
+#include <type_traits> // std::decay_t
+#include <vector>
+#include "Recipe.h"
+#include "TextScan.h"  // 이어 붙인 제목 전체를 대소문자 구분 없이 훑는 벡터 스캔
+
+using namespace std;
+
+/**
+ * RecipeColumns 클래스
+ * --------------------------
+ * 레시피 목록을 열(column) 단위의 촘촘한 배열로 펼쳐 둔 저장소 (struct-of-arrays).
+ * - difficulty, time: 레시피 하나당 1바이트 / 4바이트짜리 연속 배열
+ * - 제목: 하나의 문자열(titles)에 이어 붙이고, titleOffsets[i] ~ titleOffsets[i + 1] 구간으로 찾음
+ * - 재료: 모든 레시피의 재료 이름/단위 id를 하나의 배열에 이어 붙이고, ingredientOffsets[i] ~ ingredientOffsets[i + 1] 구간으로 찾음
+ *
+ * 난이도나 시간만 보는 필터는 큰 Recipe 객체를 건드리지 않고 이 배열들만 순서대로 읽습니다.
+ * 행 번호(i)는 RecipeDatabase의 recipes[i]와 같습니다. 로딩할 때 rebuild()로 한 번 만들고, 이후 변경은
+ * appendRow/replaceRow/eraseRows/permute로 바뀐 행만 고칩니다. (Recipe 객체에서 전체를 다시 복사하지 않음)
+ */
+class RecipeColumns
+{
+private:
+    vector<uint8_t> difficulty;          // static_cast<uint8_t>(Difficulty)
+    vector<int32_t> time;                // 조리 시간 (분)
+    vector<uint32_t> titleOffsets;       // 크기 n + 1
+    string titles;                       // 모든 제목을 이어 붙인 문자열
+    vector<uint32_t> ingredientOffsets;  // 크기 n + 1
+    vector<uint32_t> ingredientNameIds;  // SymbolTable id
+    vector<uint32_t> ingredientUnitIds;  // SymbolTable id
+    vector<double> ingredientQuantities;
+
+    // offsets[from..]에 delta를 더합니다. (한 행의 구간 길이가 바뀐 뒤 뒤쪽 행 구간을 옮길 때)
+    static void shiftOffsets(vector<uint32_t> &offsets, size_t from, int64_t delta)
+    {
+        if (delta == 0)
+            return;
+        for (size_t i = from; i < offsets.size(); i++)
+            offsets[i] = static_cast<uint32_t>(offsets[i] + delta);
+    }
+
+public:
+    /*
+     * Row: 한 행을 Recipe와 같은 이름의 접근자로 보여주는 가벼운 뷰입니다. (복사 비용은 포인터 + 인덱스)
+     * details: getTitle()은 string_view를 돌려주며, RecipeColumns가 다시 만들어지기 전까지만 유효합니다.
+     */
+    class Row
+    {
+    private:
+        const RecipeColumns *columns;
+        size_t index;
+
+    public:
+        Row(const RecipeColumns *columns, size_t index) : columns(columns), index(index) {}
+
+        size_t getIndex() const { return index; }
+        string_view getTitle() const { return columns->titleAt(index); }
+        int getTime() const { return columns->time[index]; }
+        Difficulty getDifficulty() const { return columns->difficultyAt(index); }
+        size_t getIngredientCount() const { return columns->ingredientOffsets[index + 1] - columns->ingredientOffsets[index]; }
+        uint32_t getIngredientNameId(size_t k) const { return columns->ingredientNameIds[columns->ingredientOffsets[index] + k]; }
+        uint32_t getIngredientUnitId(size_t k) const { return columns->ingredientUnitIds[columns->ingredientOffsets[index] + k]; }
+        double getIngredientQuantity(size_t k) const { return columns->ingredientQuantities[columns->ingredientOffsets[index] + k]; }
+    };
+
+    /*
+     * void rebuild(const vector<Recipe> &recipes): 레시피 목록으로 모든 열을 다시 만듭니다.
+     * details: 먼저 전체 크기를 세어 한 번에 reserve하므로 배열마다 재할당이 한 번도 일어나지 않습니다.
+     */
+    void rebuild(const vector<Recipe> &recipes)
+    {
+        size_t titleBytes = 0, ingredientTotal = 0;
+        for (const auto &recipe : recipes)
+        {
+            titleBytes += recipe.getTitle().size();
+            ingredientTotal += recipe.getIngredient().size();
+        }
+
+        clear();
+        difficulty.reserve(recipes.size());
+        time.reserve(recipes.size());
+        titleOffsets.reserve(recipes.size() + 1);
+        titles.reserve(titleBytes);
+        ingredientOffsets.reserve(recipes.size() + 1);
+        ingredientNameIds.reserve(ingredientTotal);
+        ingredientUnitIds.reserve(ingredientTotal);
+        ingredientQuantities.reserve(ingredientTotal);
+
+        titleOffsets.push_back(0);
+        ingredientOffsets.push_back(0);
+        for (const auto &recipe : recipes)
+        {
+            difficulty.push_back(static_cast<uint8_t>(recipe.getDifficulty()));
+            time.push_back(recipe.getTime());
+            titles += recipe.getTitle();
+            titleOffsets.push_back(static_cast<uint32_t>(titles.size()));
+            for (const auto &ing : recipe.getIngredient())
+            {
+                ingredientNameIds.push_back(ing.nameId);
+                ingredientUnitIds.push_back(ing.unitId);
+                ingredientQuantities.push_back(ing.quantity);
+            }
+            ingredientOffsets.push_back(static_cast<uint32_t>(ingredientNameIds.size()));
+        }
+    }
+
+    // 끝에 행 하나를 추가합니다. O(제목 길이 + 재료 수)
+    void appendRow(const Recipe &recipe)
+    {
+        if (titleOffsets.empty())
+        {
+            titleOffsets.push_back(0);
+            ingredientOffsets.push_back(0);
+        }
+        difficulty.push_back(static_cast<uint8_t>(recipe.getDifficulty()));
+        time.push_back(recipe.getTime());
+        titles += recipe.getTitle();
+        titleOffsets.push_back(static_cast<uint32_t>(titles.size()));
+        for (const auto &ing : recipe.getIngredient())
+        {
+            ingredientNameIds.push_back(ing.nameId);
+            ingredientUnitIds.push_back(ing.unitId);
+            ingredientQuantities.push_back(ing.quantity);
+        }
+        ingredientOffsets.push_back(static_cast<uint32_t>(ingredientNameIds.size()));
+    }
+
+    /*
+     * void replaceRow(size_t row, const Recipe &recipe): row 한 행을 recipe의 값으로 바꿉니다.
+     * details: 제목/재료 구간만 제자리에서 바꿔 끼우고, 길이가 달라졌으면 뒤쪽 행의 구간 시작 위치를 그만큼 옮깁니다.
+     *          (뒤쪽 바이트를 한 번 밀고 당기는 비용이며, 다른 행을 Recipe에서 다시 읽지 않음)
+     */
+    void replaceRow(size_t row, const Recipe &recipe)
+    {
+        difficulty[row] = static_cast<uint8_t>(recipe.getDifficulty());
+        time[row] = recipe.getTime();
+
+        string_view title = recipe.getTitle();
+        uint32_t titleStart = titleOffsets[row], titleEnd = titleOffsets[row + 1];
+        titles.replace(titleStart, titleEnd - titleStart, title.data(), title.size());
+        shiftOffsets(titleOffsets, row + 1, static_cast<int64_t>(title.size()) - (titleEnd - titleStart));
+
+        const auto &ingredients = recipe.getIngredient();
+        uint32_t ingStart = ingredientOffsets[row], ingEnd = ingredientOffsets[row + 1];
+        size_t oldCount = ingEnd - ingStart, newCount = ingredients.size();
+        if (newCount != oldCount)
+        {
+            auto resizeAt = [&](auto &column)
+            {
+                using Value = typename std::decay_t<decltype(column)>::value_type;
+                if (newCount > oldCount)
+                    column.insert(column.begin() + ingEnd, newCount - oldCount, Value());
+                else
+                    column.erase(column.begin() + ingStart + newCount, column.begin() + ingEnd);
+            };
+            resizeAt(ingredientNameIds);
+            resizeAt(ingredientUnitIds);
+            resizeAt(ingredientQuantities);
+            shiftOffsets(ingredientOffsets, row + 1, static_cast<int64_t>(newCount) - static_cast<int64_t>(oldCount));
+        }
+        for (size_t k = 0; k < newCount; k++)
+        {
+            ingredientNameIds[ingStart + k] = ingredients[k].nameId;
+            ingredientUnitIds[ingStart + k] = ingredients[k].unitId;
+            ingredientQuantities[ingStart + k] = ingredients[k].quantity;
+        }
+    }
+
+    /*
+     * void eraseRows(const vector<uint32_t> &rows): 오름차순 행 번호 rows를 지우고 뒤쪽 행을 앞으로 당깁니다.
+     * details: 첫 삭제 위치부터 모든 열을 한 번씩만 훑어 옮깁니다. (RecipeDatabase가 recipes를 당기는 방식과 같음)
+     */
+    void eraseRows(const vector<uint32_t> &rows)
+    {
+        if (rows.empty())
+            return;
+        size_t write = rows[0], next = 0;
+        uint32_t titleWrite = titleOffsets[write], ingWrite = ingredientOffsets[write];
+        for (size_t read = rows[0]; read < size(); read++)
+        {
+            if (next < rows.size() && rows[next] == read)
+            {
+                next++;
+                continue;
+            }
+            difficulty[write] = difficulty[read];
+            time[write] = time[read];
+            uint32_t titleStart = titleOffsets[read], titleLength = titleOffsets[read + 1] - titleStart;
+            copy(titles.begin() + titleStart, titles.begin() + titleStart + titleLength, titles.begin() + titleWrite); // 앞쪽으로만 옮기므로 겹쳐도 안전
+            titleWrite += titleLength;
+            uint32_t ingStart = ingredientOffsets[read], ingCount = ingredientOffsets[read + 1] - ingStart;
+            for (uint32_t k = 0; k < ingCount; k++)
+            {
+                ingredientNameIds[ingWrite + k] = ingredientNameIds[ingStart + k];
+                ingredientUnitIds[ingWrite + k] = ingredientUnitIds[ingStart + k];
+                ingredientQuantities[ingWrite + k] = ingredientQuantities[ingStart + k];
+            }
+            ingWrite += ingCount;
+            write++;
+            titleOffsets[write] = titleWrite;
+            ingredientOffsets[write] = ingWrite;
+        }
+        difficulty.resize(write);
+        time.resize(write);
+        titleOffsets.resize(write + 1);
+        ingredientOffsets.resize(write + 1);
+        titles.resize(titleWrite);
+        ingredientNameIds.resize(ingWrite);
+        ingredientUnitIds.resize(ingWrite);
+        ingredientQuantities.resize(ingWrite);
+    }
+
+    /*
+     * void permute(const vector<uint32_t> &order): 새 행 i가 이전 행 order[i]가 되도록 행을 재배치합니다. (정렬 후 사용)
+     * details: 열 자신의 값으로 새 배열을 만들어 바꿔 끼웁니다.
+     */
+    void permute(const vector<uint32_t> &order)
+    {
+        RecipeColumns sorted;
+        sorted.difficulty.reserve(order.size());
+        sorted.time.reserve(order.size());
+        sorted.titleOffsets.reserve(order.size() + 1);
+        sorted.titles.reserve(titles.size());
+        sorted.ingredientOffsets.reserve(order.size() + 1);
+        sorted.ingredientNameIds.reserve(ingredientNameIds.size());
+        sorted.ingredientUnitIds.reserve(ingredientUnitIds.size());
+        sorted.ingredientQuantities.reserve(ingredientQuantities.size());
+        sorted.titleOffsets.push_back(0);
+        sorted.ingredientOffsets.push_back(0);
+        for (uint32_t row : order)
+        {
+            sorted.difficulty.push_back(difficulty[row]);
+            sorted.time.push_back(time[row]);
+            sorted.titles += titleAt(row);
+            sorted.titleOffsets.push_back(static_cast<uint32_t>(sorted.titles.size()));
+            for (uint32_t k = ingredientOffsets[row]; k < ingredientOffsets[row + 1]; k++)
+            {
+                sorted.ingredientNameIds.push_back(ingredientNameIds[k]);
+                sorted.ingredientUnitIds.push_back(ingredientUnitIds[k]);
+                sorted.ingredientQuantities.push_back(ingredientQuantities[k]);
+            }
+            sorted.ingredientOffsets.push_back(static_cast<uint32_t>(sorted.ingredientNameIds.size()));
+        }
+        *this = std::move(sorted);
+    }
+
+    void clear()
+    {
+        difficulty.clear();
+        time.clear();
+        titleOffsets.clear();
+        titles.clear();
+        ingredientOffsets.clear();
+        ingredientNameIds.clear();
+        ingredientUnitIds.clear();
+        ingredientQuantities.clear();
+    }
+
+    size_t size() const { return difficulty.size(); }
+    Row row(size_t i) const { return Row(this, i); }
+
+    Difficulty difficultyAt(size_t i) const { return static_cast<Difficulty>(difficulty[i]); }
+    int timeAt(size_t i) const { return time[i]; }
+    string_view titleAt(size_t i) const
+    {
+        return string_view(titles).substr(titleOffsets[i], titleOffsets[i + 1] - titleOffsets[i]);
+    }
+
+    /*
+     * vector<uint32_t> selectRows(Predicate keep) const: keep(Row)이 true인 행 번호를 순서대로 모읍니다.
+     * details: Row는 필요한 열만 읽으므로, 난이도만 보는 조건이면 difficulty 배열만 순서대로 훑게 됩니다.
+     */
+    template <typename Predicate>
+    vector<uint32_t> selectRows(Predicate keep) const
+    {
+        vector<uint32_t> rows;
+        for (size_t i = 0; i < size(); i++)
+        {
+            if (keep(Row(this, i)))
+                rows.push_back(static_cast<uint32_t>(i));
+        }
+        return rows;
+    }
+
+    /*
+     * void forEachTitleContaining(string_view lowerNeedle, Visitor visit) const: 제목에 lowerNeedle이 (대소문자 구분 없이) 들어 있는 행마다
+     * visit(row)를 오름차순으로 한 번씩 호출합니다.
+     * details: 행마다 따로 찾지 않고, 이어 붙인 제목 문자열 전체를 TextScan으로 훑은 뒤 일치 위치를 행 번호로 바꿉니다.
+     *          제목 사이에 구분자가 없으므로 두 제목에 걸친 일치는 버리고 다음 위치부터 다시 찾습니다.
+     */
+    template <typename Visitor>
+    void forEachTitleContaining(string_view lowerNeedle, Visitor visit) const
+    {
+        if (lowerNeedle.empty())
+        {
+            for (size_t row = 0; row < size(); row++)
+                visit(static_cast<uint32_t>(row));
+            return;
+        }
+        string_view all(titles);
+        size_t pos = TextScan::findFolded(all, lowerNeedle);
+        size_t row = 0;
+        while (pos != TextScan::npos && pos < all.size())
+        {
+            // pos는 계속 커지므로 이전 행부터 찾음: 바로 뒤 몇 행을 먼저 보고, 멀면 이진 탐색
+            size_t step = 0;
+            while (step < 8 && titleOffsets[row + 1] <= pos)
+            {
+                row++;
+                step++;
+            }
+            if (titleOffsets[row + 1] <= pos)
+                row = static_cast<size_t>(upper_bound(titleOffsets.begin() + row, titleOffsets.end(), static_cast<uint32_t>(pos)) - titleOffsets.begin() - 1);
+            if (pos + lowerNeedle.size() <= titleOffsets[row + 1])
+            {
+                visit(static_cast<uint32_t>(row));
+                pos = TextScan::findFolded(all, lowerNeedle, titleOffsets[row + 1]);
+            }
+            else
+                pos = TextScan::findFolded(all, lowerNeedle, pos + 1);
+        }
+    }
+
+    // 난이도가 allowed[d]인 행 번호 (allowed는 A, B, C 순서)
+    vector<uint32_t> selectByDifficulty(const bool (&allowed)[3]) const
+    {
+        vector<uint32_t> rows;
+        const uint8_t *d = difficulty.data();
+        for (size_t i = 0; i < difficulty.size(); i++)
+        {
+            if (allowed[d[i]])
+                rows.push_back(static_cast<uint32_t>(i));
+        }
+        return rows;
+    }
+};
+
+#endif // RECIPE_COLUMNS_H
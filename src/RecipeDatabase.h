@@ -8,15 +8,79 @@
 #include <sstream>     // std::istringstream: 문자열을 스트림처럼 다루기 위해 포함합니다. 문자열을 특정 구분자로 분리(파싱)할 때 유용합니다.
 #include <algorithm>   // std::transform, std::sort, std::remove_if 등 범용 알고리즘 함수를 사용하기 위해 포함합니다.
 #include <limits>      // std::numeric_limits: 특정 타입의 최대값 등 숫자 한계에 대한 정보를 얻기 위해 포함합니다. 입력 버퍼를 비울 때 사용됩니다.
+#include <string_view> // std::string_view: 메모리 매핑된 파일을 복사 없이 잘라 읽기 위해 포함합니다.
+#include <charconv>    // std::from_chars: 예외/할당 없이 문자열 뷰에서 숫자를 읽기 위해 포함합니다.
+#include <thread>      // std::thread: 레시피 파일을 여러 코어에서 나누어 파싱하기 위해 포함합니다.
+#include <iterator>    // std::back_inserter: 파싱된 조각을 순서대로 이어 붙일 때 사용합니다.
+#include <memory>      // std::shared_ptr, std::make_shared: 지연 로딩용 ProcedureSource를 레시피들이 공유합니다.
+#include <cstdio>      // std::rename, std::remove: 임시 파일에 저장한 뒤 원본과 교체하기 위해 포함합니다.
 #include "Recipe.h"    // Recipe 클래스 헤더 포함합니다.
+#include "MappedFile.h" // MappedFile: 파일을 메모리에 매핑하는 RAII 클래스
+#include "RecipeSnapshot.h" // RecipeSnapshot: 빠른 시작을 위한 바이너리 스냅샷 형식
+#include "AtomicFile.h"   // AtomicFile: 임시 파일 + fsync + rename으로 파일을 원자적으로 교체
+#include "SymbolTable.h"  // SymbolTable: 재료 이름/단위 문자열 -> 정수 id
+#include "RecipeColumns.h" // RecipeColumns: 필터 스캔용 열(column) 단위 배열
+#include "RecipeSearchIndex.h" // RecipeSearchIndex: 제목/재료 키워드 검색용 역색인
+#include "DifficultyBuckets.h" // DifficultyBuckets: 난이도별 행 번호 목록 (추천/식단 생성용)
+#include "RecipeQuery.h" // RecipeQuery: 난이도/시간/재료 조건을 비트맵으로 합치는 다중 조건 질의
+#include "PantryIndex.h" // PantryIndex: 가진 재료로 만들 수 있는 레시피 질의용 재료 비트 집합
+#include <chrono>      // std::chrono: 저장에 걸린 시간 측정
+#include <filesystem>  // std::filesystem: 스냅샷이 원본 텍스트보다 오래되었는지 확인하기 위해 포함합니다.
 
 using namespace std;
 
+// saveToFile() 한 번의 결과: 쓴 바이트 수와 단계별 소요 시간
+struct SaveReport
+{
+    bool ok = false;
+    uint64_t bytes = 0;
+    double serializeSeconds = 0.0; // 메모리 버퍼로 직렬화
+    double writeSeconds = 0.0;     // 임시 파일 쓰기 + fsync + rename
+    string error;
+};
+
+/*
+ * struct IngredientIssue: 재료 줄에서 발견한 잘못된 항목 하나에 대한 정보입니다.
+ * details: entry는 파싱한 원본 줄을 가리키는 뷰이므로, 원본 문자열이 살아있는 동안만 유효합니다.
+ */
+struct IngredientIssue
+{
+    size_t offset;      // 줄 안에서 항목이 시작하는 위치
+    string_view entry;  // 문제가 된 항목
+    const char *reason; // 문제 설명
+};
+
 class RecipeDatabase
 {
 private:
     vector<Recipe> recipes;
+    shared_ptr<SymbolTable> symbols = make_shared<SymbolTable>(); // 재료 이름/단위 심볼 표 (로딩할 때마다 새로 만듦)
+    shared_ptr<TextArena> arena = make_shared<TextArena>();      // 레시피 제목/조리 절차 문자열 아레나 (로딩할 때마다 새로 만듦)
+    size_t arenaPeakBytes = 0;                                    // 이전 아레나(압축 전)까지 포함한 최대 점유량
+
+    // 레시피 목록의 열 저장소. 로딩이 끝날 때 만들고, 이후에는 삽입/수정/삭제/정렬 때 바뀐 행만 고칩니다.
+    RecipeColumns columns;
+    // 레시피별 재료 비트 집합. 변경 때 recipesChanged()가 오래된 것으로 표시하고, 다음 재료 질의 때 다시 만듭니다.
+    mutable PantryIndex pantryIndex;
+    mutable bool pantryStale = true;
+    // 키워드 검색용 역색인 + 제목 해시 색인. 로딩이 끝날 때 만들고, 이후에는 삽입/수정/삭제/정렬 때마다 바로 갱신합니다.
+    RecipeSearchIndex searchIndex;
+    // 난이도별 레시피 id 목록. 로딩 때 만들고, 삽입/수정/삭제 때는 바뀐 레시피의 id만 옮깁니다. (정렬은 id를 바꾸지 않음)
+    DifficultyBuckets difficultyBuckets;
     string filename;
+    bool lazyProcedures = false; // true면 조리 절차를 파일 위치만 기억했다가 처음 접근할 때 읽음
+
+    // 변경 저널: 삽입/수정/삭제/정렬을 일어날 때마다 저널 파일 끝에 덧붙이고, 로딩할 때 다시 적용합니다.
+    bool journaling = false;
+    string journalPath;
+    uint64_t journalBytes = 0;                  // 현재 저널 파일 크기 (0이면 저널 없음)
+    uint64_t journalCompactThreshold = 4 << 20; // 저널이 이 크기를 넘으면 save()가 기본 파일로 합침 (기본 4MB)
+    bool unjournaledChanges = false;            // 저널에 기록하지 못한 변경이 있음 (save() 때 전체 저장 필요)
+
+    SyncPolicy syncPolicy = SyncPolicy::FileAndDirectory; // 저장 시 디스크 동기화 정책
+    SaveReport lastSave;                                  // 마지막 saveToFile()의 결과
+
+    static constexpr size_t kSearchPageSize = 10; // searchRecipe()가 한 번에 출력하는 검색 결과 수
 
     // --- Private Helper Functions ---
 
@@ -27,7 +91,7 @@ private:
      * return 공백이 제거된 새로운 문자열
      */
     // 문자열 좌우 공백 제거 헬퍼 함수
-    string trim(const string &str)
+    static string trim(const string &str)
     {
         size_t first = str.find_first_not_of(" \t\n\r");
         if (string::npos == first)
@@ -58,14 +122,14 @@ private:
 
 
     /*
-     * static string toLower(const string &str): 문자열 전체를 소문자로 변환합니다. 대소문자 구분 없는 검색을 위해 사용됩니다.
+     * static string toLower(string_view str): 문자열 전체를 소문자로 변환합니다. 대소문자 구분 없는 검색을 위해 사용됩니다.
      * param str 원본 문자열
      * details: algorithm 헤더의 transform 함수를 사용하여 문자열의 각 문자에 tolower 함수를 적용합니다.
      * return 모두 소문자로 변환된 새로운 문자열
      */
-    static string toLower(const string &str)
+    static string toLower(string_view str)
     {
-        string lower_str = str;
+        string lower_str(str);
         transform(lower_str.begin(), lower_str.end(), lower_str.begin(),
                   [](unsigned char c)
                   { return tolower(c); });
@@ -106,34 +170,685 @@ private:
         }
     }
 
+    /*
+     * static void appendRecipeText(string &out, const Recipe &recipe): 레시피 하나를 Recipe.txt 형식으로 out 뒤에 덧붙입니다.
+     * details: saveToFile과 변경 저널이 같은 직렬화 함수를 사용하므로 두 형식이 항상 일치합니다.
+     * 재료 양은 ofstream의 기본 출력(유효 숫자 6자리, %g)과 같은 형식으로 씁니다.
+     */
+    static void appendRecipeText(string &out, const Recipe &recipe)
+    {
+        out += "Recipe name: ";
+        out += recipe.getTitle();
+        out += "\nRecipe Procedure:\n";
+        recipe.appendProcedureTo(out);
+        out += "\nTime: ";
+        out += to_string(recipe.getTime());
+        out += "\nIngredients: ";
+        const auto &ingredients = recipe.getIngredient();
+        for (size_t j = 0; j < ingredients.size(); ++j)
+        {
+            const auto &ing = ingredients[j];
+            char quantity[32];
+            int length = snprintf(quantity, sizeof(quantity), "%g", ing.quantity);
+            out += recipe.ingredientName(ing);
+            out += '|';
+            out.append(quantity, length);
+            out += '|';
+            out += recipe.ingredientUnit(ing);
+            if (j < ingredients.size() - 1)
+                out += ", ";
+        }
+        out += "\nGrade: ";
+        out += difficultyToString(recipe.getDifficulty());
+        out += "\n\n";
+    }
+
+    // --- string_view 기반 헬퍼 (메모리 매핑 로더용) ---
+    // 아래 함수들은 기존 헬퍼(trim, split, stoi, stod)와 결과가 같도록 작성되었지만, 새 문자열을 만들지 않습니다.
+
+    /*
+     * static string_view trimView(string_view s): trim()과 같은 규칙으로 좌우 공백을 잘라낸 '뷰'를 반환합니다.
+     * details: trim()과 결과를 맞추기 위해 공백만 있는 문자열은 그대로 반환합니다.
+     */
+    static string_view trimView(string_view s)
+    {
+        size_t first = s.find_first_not_of(" \t\n\r");
+        if (first == string_view::npos)
+            return s;
+        size_t last = s.find_last_not_of(" \t\n\r");
+        return s.substr(first, last - first + 1);
+    }
+
+    /*
+     * static bool parseIntView(string_view s, int &out): stoi와 같이 앞부분의 정수를 읽습니다. ('+' 부호 허용)
+     * return 숫자를 하나도 읽지 못했으면 false
+     */
+    static bool parseIntView(string_view s, int &out)
+    {
+        const char *first = s.data();
+        const char *last = s.data() + s.size();
+        if (first != last && *first == '+')
+            ++first;
+        return from_chars(first, last, out).ec == errc();
+    }
+
+    /*
+     * static bool parseDoubleView(string_view s, double &out): stod와 같이 앞부분의 실수를 읽습니다. ('+' 부호, 0x 16진수 허용)
+     * return 숫자를 하나도 읽지 못했으면 false
+     */
+    static bool parseDoubleView(string_view s, double &out)
+    {
+        const char *first = s.data();
+        const char *last = s.data() + s.size();
+        bool negative = false;
+        if (first != last && (*first == '+' || *first == '-'))
+        {
+            negative = (*first == '-');
+            ++first;
+        }
+        chars_format format = chars_format::general;
+        if (last - first > 2 && first[0] == '0' && (first[1] == 'x' || first[1] == 'X'))
+        {
+            first += 2;
+            format = chars_format::hex;
+        }
+        double value = 0;
+        if (first == last || *first == '+' || *first == '-' || from_chars(first, last, value, format).ec != errc())
+            return false;
+        out = negative ? -value : value;
+        return true;
+    }
+
+    // stringToDifficulty의 string_view 버전
+    static Difficulty viewToDifficulty(string_view s)
+    {
+        if (s.size() == 1)
+        {
+            switch (s[0])
+            {
+            case 'b':
+            case 'B':
+                return Difficulty::B;
+            case 'c':
+            case 'C':
+                return Difficulty::C;
+            }
+        }
+        return Difficulty::A; // 기본값 (a, A 포함)
+    }
+
+    /*
+     * static size_t parseIngredientList(string_view line, vector<Ingredient> &out, SymbolTable &table, vector<IngredientIssue> *issues):
+     * "이름|양|단위, 이름|양|단위" 형식의 재료 줄을 한 번 훑으며 파싱해 out 뒤에 덧붙입니다.
+     * details: 항목마다 ','까지 한 번만 훑으면서 '|' 위치를 기록하고, 토큰은 임시 문자열 없이 뷰로 잘라 냅니다.
+     * 양은 from_chars(parseDoubleView)로 읽으므로 예외가 발생하지 않습니다.
+     * 이름과 단위는 table에 인터닝하여 id로 저장하므로, 이미 본 재료/단위는 문자열을 전혀 복사하지 않습니다.
+     * 결과는 기존 split/stod 기반 파서와 같습니다:
+     * - 필드 수가 3이 아닌 항목은 건너뜀 (단, 끝의 빈 필드는 getline처럼 세지 않으므로 "a|1|u|"는 유효)
+     * - 양을 숫자로 읽을 수 없으면 0으로 저장
+     * 건너뛰거나 양을 0으로 바꾼 항목은 issues에 기록합니다. (nullptr이면 기록하지 않음)
+     * return 문제가 있었던 항목 수
+     */
+    static size_t parseIngredientList(string_view line, vector<Ingredient> &out, SymbolTable &table, vector<IngredientIssue> *issues = nullptr)
+    {
+        size_t problems = 0;
+        auto report = [&](size_t offset, string_view entry, const char *reason) {
+            problems++;
+            if (issues)
+                issues->push_back({offset, entry, reason});
+        };
+
+        const char *data = line.data();
+        const size_t n = line.size();
+        size_t entryStart = 0;
+        while (entryStart < n)
+        {
+            size_t bars[3] = {0, 0, 0};
+            size_t barCount = 0;
+            size_t i = entryStart;
+            for (; i < n && data[i] != ','; ++i)
+            {
+                if (data[i] == '|')
+                {
+                    if (barCount < 3)
+                        bars[barCount] = i - entryStart;
+                    barCount++;
+                }
+            }
+            string_view raw = line.substr(entryStart, i - entryStart);
+            string_view entry = trimView(raw);
+            size_t shift = static_cast<size_t>(entry.data() - raw.data()); // 앞쪽 공백만큼 '|' 위치를 보정
+            size_t offset = entryStart + shift;
+            entryStart = i + 1;
+
+            bool trailingBar = !entry.empty() && entry.back() == '|';
+            size_t fields = entry.empty() ? 0 : barCount + 1 - (trailingBar ? 1 : 0);
+            if (fields != 3)
+            {
+                bool blank = entry.find_first_not_of(" \t\n\r") == string_view::npos;
+                report(offset, entry, blank ? "is empty" : "is not in name|quantity|unit form");
+                continue;
+            }
+
+            size_t nameEnd = bars[0] - shift;
+            size_t quantityEnd = bars[1] - shift;
+            size_t unitEnd = barCount == 3 ? bars[2] - shift : entry.size();
+            string_view quantityText = trimView(entry.substr(nameEnd + 1, quantityEnd - nameEnd - 1));
+
+            Ingredient ing;
+            ing.nameId = table.intern(trimView(entry.substr(0, nameEnd)));
+            if (!parseDoubleView(quantityText, ing.quantity))
+            {
+                ing.quantity = 0;
+                report(offset, entry, "has an invalid quantity (stored as 0)");
+            }
+            ing.unitId = table.intern(trimView(entry.substr(quantityEnd + 1, unitEnd - quantityEnd - 1)));
+            out.push_back(std::move(ing));
+        }
+        return problems;
+    }
+
+    /*
+     * struct TextParseSummary: parseRecipeText가 청크(파일 일부)를 파싱한 뒤 돌려주는 '이어 붙이기' 정보입니다.
+     * details: 기존 파서는 레시피마다 Time과 Grade 값을 초기화하지 않으므로, 해당 줄이 없는 레시피는 바로 앞 레시피의 값을 물려받습니다.
+     * 병렬 파싱 시 청크 앞부분의 레시피는 앞 청크의 마지막 값을 알 수 없으므로, 몇 개가 물려받았는지 기록해 두었다가 병합할 때 채웁니다.
+     */
+    struct TextParseSummary
+    {
+        size_t timeInherited = 0;  // 청크에서 첫 'Time:' 줄 전에 저장된 레시피 수
+        size_t gradeInherited = 0; // 청크에서 첫 'Grade:' 줄 전에 저장된 레시피 수
+        bool timeSeen = false;
+        bool gradeSeen = false;
+        size_t ingredientIssues = 0; // 건너뛰거나 양을 0으로 바꾼 재료 항목 수
+        int lastTime = 0;
+        Difficulty lastGrade = Difficulty::A;
+    };
+
+    /*
+     * static bool isRecordStart(string_view line, string_view &title): 해당 줄이 'Recipe name:' 줄(레코드 시작)인지 확인합니다.
+     * details: 'Recipe name' 키는 조리 절차를 읽는 중에도 항상 새 레시피를 시작시키므로, 파일을 이 줄 앞에서 자르면 레코드가 깨지지 않습니다.
+     * return 레코드 시작 줄이면 true, 이때 title에 레시피 이름(뷰)을 담습니다.
+     */
+    static bool isRecordStart(string_view line, string_view &title)
+    {
+        string_view trimmed_line = trimView(line);
+        size_t colon_pos = trimmed_line.find(':');
+        if (colon_pos == string_view::npos || trimView(trimmed_line.substr(0, colon_pos)) != "Recipe name")
+            return false;
+        title = trimView(trimmed_line.substr(colon_pos + 1));
+        return true;
+    }
+
+    /*
+     * TextParseSummary parseRecipeText(string_view text, vector<Recipe> &out, const shared_ptr<SymbolTable> &table, const shared_ptr<TextArena> &textArena,
+     *                                  const shared_ptr<const ProcedureSource> &lazySource):
+     * 메모리에 올라온 Recipe.txt(또는 그 일부)를 파싱하여 out에 레시피를 추가합니다. 재료 이름/단위는 table에, 제목/조리 절차는 textArena에 저장합니다.
+     * details: loadFromFile과 같은 상태 기계(isReadingProcedure)를 사용하지만, 줄과 필드를 모두 string_view 커서로 다룹니다.
+     * 각 필드는 최종 저장 위치(아레나)로 딱 한 번만 복사되며, 레시피마다 문자열 할당(malloc)이 일어나지 않습니다.
+     * lazySource가 주어지면 조리 절차는 복사하지 않고 원본 줄 구간(위치, 길이)만 기록합니다. 이때 text는 lazySource->view()의 일부여야 합니다.
+     * (한 레시피 안에서 'Recipe Procedure:'가 여러 번 나와 구간이 끊어지는 드문 경우에는 그 레시피만 즉시 읽습니다.)
+     * return 병렬 병합에 필요한 Time/Grade 상속 정보
+     */
+    static TextParseSummary parseRecipeText(string_view text, vector<Recipe> &out, const shared_ptr<SymbolTable> &table,
+                                            const shared_ptr<TextArena> &textArena,
+                                            const shared_ptr<const ProcedureSource> &lazySource = nullptr)
+    {
+        TextParseSummary summary;
+        string currentTitle, currentProcedure;
+        int currentTime = 0;
+        vector<Ingredient> currentIngredient;
+        Difficulty currentDifficulty = Difficulty::A;
+        bool isReadingProcedure = false;
+
+        // 지연 로딩용: 현재 레시피의 조리 절차 원본 구간
+        const char *procedureBegin = nullptr;
+        const char *procedureEnd = nullptr;
+        bool procedureLoadedNow = (lazySource == nullptr);
+
+        auto createAndStoreRecipe = [&]() {
+            if (!currentTitle.empty()) {
+                if (procedureLoadedNow || procedureBegin == nullptr) {
+                    ProcedureSource::finish(currentProcedure);
+                    out.emplace_back(currentTitle, currentProcedure, currentTime, std::move(currentIngredient), currentDifficulty, table, textArena);
+                } else {
+                    out.emplace_back(currentTitle, lazySource,
+                                     static_cast<uint64_t>(procedureBegin - lazySource->view().data()),
+                                     static_cast<uint32_t>(procedureEnd - procedureBegin),
+                                     currentTime, std::move(currentIngredient), currentDifficulty, table, textArena);
+                }
+                if (!summary.timeSeen)
+                    summary.timeInherited++;
+                if (!summary.gradeSeen)
+                    summary.gradeInherited++;
+                currentTitle.clear();
+                currentProcedure.clear();
+                currentIngredient.clear();
+                procedureBegin = procedureEnd = nullptr;
+                procedureLoadedNow = (lazySource == nullptr);
+            }
+        };
+
+        auto isSectionKey = [](string_view key) {
+            return key == "Time" || key == "Ingredients" || key == "Grade" || key == "Recipe name";
+        };
+
+        size_t pos = 0;
+        while (pos < text.size()) {
+            size_t end = text.find('\n', pos);
+            if (end == string_view::npos)
+                end = text.size();
+            string_view line = text.substr(pos, end - pos);
+            string_view trimmed_line = trimView(line);
+            pos = end + 1;
+
+            if (isReadingProcedure) {
+                size_t colon_pos = trimmed_line.find(':');
+                if (colon_pos != string_view::npos && isSectionKey(trimView(trimmed_line.substr(0, colon_pos)))) {
+                    isReadingProcedure = false;
+                }
+            }
+            if (isReadingProcedure) {
+                if (procedureLoadedNow) {
+                    ProcedureSource::appendLine(currentProcedure, trimmed_line);
+                } else {
+                    if (procedureBegin == nullptr)
+                        procedureBegin = line.data();
+                    procedureEnd = line.data() + line.size();
+                }
+                continue;
+            }
+            size_t colon_pos = trimmed_line.find(':');
+            if (colon_pos != string_view::npos) {
+                string_view key = trimView(trimmed_line.substr(0, colon_pos));
+                string_view value = trimView(trimmed_line.substr(colon_pos + 1));
+
+                if (key == "Recipe name") {
+                    createAndStoreRecipe();
+                    currentTitle.assign(value);
+                } else if (key == "Recipe Procedure") {
+                    isReadingProcedure = true;
+                    if (!procedureLoadedNow && procedureBegin != nullptr) {
+                        // 조리 절차 구간이 끊어짐: 지금까지의 구간을 읽어 두고 이 레시피는 즉시 읽기로 전환
+                        ProcedureSource::appendRawLines(currentProcedure, string_view(procedureBegin, procedureEnd - procedureBegin));
+                        procedureBegin = procedureEnd = nullptr;
+                        procedureLoadedNow = true;
+                    }
+                } else if (key == "Time") {
+                    if (!parseIntView(value, currentTime))
+                        currentTime = 0;
+                    summary.timeSeen = true;
+                } else if (key == "Ingredients") {
+                    currentIngredient.clear();
+                    summary.ingredientIssues += parseIngredientList(value, currentIngredient, *table);
+                } else if (key == "Grade") {
+                    currentDifficulty = viewToDifficulty(value);
+                    summary.gradeSeen = true;
+                }
+            }
+        }
+        createAndStoreRecipe();
+        summary.lastTime = currentTime;
+        summary.lastGrade = currentDifficulty;
+        return summary;
+    }
+
+    /*
+     * static vector<string_view> splitAtRecordBoundaries(string_view text, size_t chunkCount): 파일을 약 chunkCount개의 조각으로 나눕니다.
+     * details: 균등 분할 위치에서 다음 'Recipe name:' 줄의 시작까지 앞으로 이동한 뒤 자르므로, 모든 조각은 레코드 경계에서 시작합니다.
+     * 이름이 빈 레코드는 저장되지 않고 조리 절차/재료가 다음 레코드로 넘어가므로, 바로 앞 레코드의 이름이 비어 있지 않은 경계에서만 자릅니다.
+     * 첫 조각은 항상 파일의 처음부터 시작합니다. (첫 레시피 앞의 내용도 serial 파서와 똑같이 처리하기 위해)
+     */
+    static vector<string_view> splitAtRecordBoundaries(string_view text, size_t chunkCount)
+    {
+        vector<string_view> chunks;
+        size_t chunkStart = 0;
+        for (size_t i = 1; i < chunkCount && chunkStart < text.size(); i++)
+        {
+            size_t target = max(chunkStart + 1, text.size() / chunkCount * i);
+            // target이 속한 줄의 다음 줄부터 레코드 시작 줄을 찾습니다.
+            size_t pos = text.find('\n', target - 1);
+            size_t boundary = text.size();
+            bool seenRecord = false;    // 앞쪽 레코드 시작 줄을 이미 지났는지
+            bool previousTitled = false; // 그 레코드의 이름이 비어 있지 않은지
+            while (pos != string_view::npos && pos + 1 < text.size())
+            {
+                size_t lineStart = pos + 1;
+                size_t lineEnd = text.find('\n', lineStart);
+                if (lineEnd == string_view::npos)
+                    lineEnd = text.size();
+                string_view title;
+                if (isRecordStart(text.substr(lineStart, lineEnd - lineStart), title))
+                {
+                    if (seenRecord && previousTitled)
+                    {
+                        boundary = lineStart;
+                        break;
+                    }
+                    seenRecord = true;
+                    previousTitled = !title.empty();
+                }
+                pos = lineEnd < text.size() ? lineEnd : string_view::npos;
+            }
+            if (boundary >= text.size())
+                break;
+            chunks.push_back(text.substr(chunkStart, boundary - chunkStart));
+            chunkStart = boundary;
+        }
+        chunks.push_back(text.substr(chunkStart));
+        return chunks;
+    }
+
+    // 새로 로딩하기 전에 심볼 표와 아레나를 새로 만듭니다. (getRecipes()에서 꺼내 값으로 복사해 둔 Recipe는 이전 것을 계속 공유)
+    void resetStorage()
+    {
+        arenaPeakBytes = max(arenaPeakBytes, arena->getPeakReservedBytes());
+        symbols = make_shared<SymbolTable>();
+        arena = make_shared<TextArena>();
+    }
+
+    // 삭제/수정으로 쌓인 쓰레기가 살아있는 데이터보다 많아지면(1MB 이상일 때) 자동으로 압축합니다.
+    void maybeCompactArena()
+    {
+        const size_t minGarbage = 1u << 20;
+        if (arena->getGarbageBytes() >= minGarbage && arena->getGarbageBytes() > arena->getLiveBytes())
+            compactArena();
+    }
+
+    // --- 변경 적용 (대화형 기능과 저널 재적용이 함께 사용) ---
+
+    // recipes가 바뀔 때마다 호출: 바뀐 행만 고치지 않는 파생 자료구조를 오래된 것으로 표시합니다.
+    void recipesChanged()
+    {
+        pantryStale = true;
+    }
+
+    void applyInsert(Recipe recipe)
+    {
+        recipes.push_back(std::move(recipe));
+        searchIndex.insert(recipes.back());
+        difficultyBuckets.insert(searchIndex.idAt(recipes.size() - 1), recipes.back().getDifficulty());
+        columns.appendRow(recipes.back());
+        recipesChanged();
+    }
+
+    // lookupTitle과 대소문자 구분 없이 같은 첫 레시피를 updated로 바꿉니다.
+    bool applyEdit(const string &lookupTitle, Recipe updated)
+    {
+        vector<uint32_t> rows = searchIndex.rowsWithTitleKey(Recipe::foldKey(lookupTitle), recipes);
+        if (rows.empty())
+            return false;
+        Recipe &recipe = recipes[rows[0]];
+        Difficulty before = recipe.getDifficulty();
+        searchIndex.beforeEdit(rows[0], recipe);
+        recipe.releaseText();
+        recipe = std::move(updated);
+        searchIndex.afterEdit(rows[0], recipe);
+        difficultyBuckets.change(searchIndex.idAt(rows[0]), before, recipe.getDifficulty());
+        columns.replaceRow(rows[0], recipe);
+        recipesChanged();
+        maybeCompactArena();
+        return true;
+    }
+
+    // 제목이 정확히 같은 레시피를 모두 삭제합니다.
+    // 지울 행은 제목 해시 색인으로 바로 찾고, 첫 삭제 위치부터 뒤쪽 레시피만 한 번에 앞으로 당깁니다.
+    bool applyDelete(const string &title)
+    {
+        vector<uint32_t> rows = searchIndex.rowsWithTitle(title, recipes);
+        if (rows.empty())
+            return false;
+        for (uint32_t row : rows)
+        {
+            recipes[row].releaseText();
+            difficultyBuckets.erase(searchIndex.idAt(row), recipes[row].getDifficulty());
+            searchIndex.markErased(row, recipes[row]);
+        }
+        size_t write = rows[0];
+        size_t next = 0;
+        for (size_t read = rows[0]; read < recipes.size(); read++)
+        {
+            if (next < rows.size() && rows[next] == read)
+            {
+                next++;
+                continue;
+            }
+            recipes[write++] = std::move(recipes[read]);
+        }
+        recipes.erase(recipes.begin() + write, recipes.end());
+        searchIndex.eraseMarkedRows();
+        columns.eraseRows(rows);
+        recipesChanged();
+        maybeCompactArena();
+        return true;
+    }
+
+    // 행 번호 순서(order)를 제목으로 정렬한 뒤 그 순서대로 옮깁니다. (같은 비교를 하므로 레시피를 직접 정렬한 결과와 같음)
+    // 색인은 레시피 id를 그대로 두고 행 번호 대응표만 바꿉니다.
+    void applySort()
+    {
+        vector<uint32_t> order(recipes.size());
+        for (size_t row = 0; row < order.size(); row++)
+            order[row] = static_cast<uint32_t>(row);
+        sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+             { return recipes[a].getTitle() < recipes[b].getTitle(); });
+        vector<Recipe> sorted;
+        sorted.reserve(recipes.size());
+        for (uint32_t row : order)
+            sorted.push_back(std::move(recipes[row]));
+        recipes = std::move(sorted);
+        searchIndex.permute(order);
+        columns.permute(order);
+        recipesChanged();
+    }
+
+    // --- 변경 저널 내부 함수 ---
+
+    /*
+     * void appendJournal(const char *op, const string &payload): 저널 파일 끝에 레코드 하나를 덧붙입니다.
+     * details: 저널이 비어 있으면 먼저 @base 줄(기본 파일의 크기/수정 시각)을 씁니다.
+     * 기본 파일이 없거나 쓰기에 실패하면 unjournaledChanges를 표시해 save() 때 전체 저장하도록 합니다.
+     */
+    void appendJournal(const char *op, const string &payload)
+    {
+        if (!journaling)
+            return;
+        string record;
+        if (journalBytes == 0)
+        {
+            uint64_t baseSize = 0;
+            int64_t baseMtime = 0;
+            if (!textSourceInfo(filename, baseSize, baseMtime))
+            {
+                unjournaledChanges = true;
+                return;
+            }
+            record = "@base " + to_string(baseSize) + " " + to_string(baseMtime) + "\n";
+        }
+        record += "@";
+        record += op;
+        record += " " + to_string(payload.size()) + "\n";
+        record += payload;
+        record += "\n";
+
+        ofstream journal(journalPath, ios::binary | ios::app);
+        journal.write(record.data(), static_cast<streamsize>(record.size()));
+        journal.close();
+        if (journal.fail())
+        {
+            unjournaledChanges = true;
+            return;
+        }
+        journalBytes += record.size();
+    }
+
+    void clearJournal()
+    {
+        if (journalBytes > 0)
+            remove(journalPath.c_str());
+        journalBytes = 0;
+        unjournaledChanges = false;
+    }
+
+    // 한 줄(@op n)을 읽어 op와 n을 돌려줍니다. pos는 다음 줄의 시작으로 이동합니다.
+    static bool readJournalHeader(string_view data, size_t &pos, string_view &op, string_view &arguments)
+    {
+        size_t end = data.find('\n', pos);
+        if (end == string_view::npos || data[pos] != '@')
+            return false;
+        string_view line = data.substr(pos + 1, end - pos - 1);
+        size_t space = line.find(' ');
+        if (space == string_view::npos)
+            return false;
+        op = line.substr(0, space);
+        arguments = line.substr(space + 1);
+        pos = end + 1;
+        return true;
+    }
+
+    /*
+     * void replayJournal(): 기본 파일을 읽은 뒤 저널의 변경 내용을 순서대로 다시 적용합니다.
+     * details: 다른 기본 파일 위에 쌓인(이미 합쳐진) 저널은 버립니다.
+     * 마지막 레코드가 중간에 끊겨 있으면(쓰는 도중 종료) 그 앞까지만 적용하고 파일도 그 길이로 자릅니다.
+     */
+    void replayJournal()
+    {
+        MappedFile file;
+        if (!file.open(journalPath))
+            return;
+        string_view data = file.view();
+        size_t pos = 0;
+        string_view op, arguments;
+
+        uint64_t baseSize = 0, expectedSize = 0;
+        int64_t baseMtime = 0, expectedMtime = 0;
+        bool baseMatches = false;
+        if (readJournalHeader(data, pos, op, arguments) && op == "base" && textSourceInfo(filename, baseSize, baseMtime))
+        {
+            size_t space = arguments.find(' ');
+            baseMatches = space != string_view::npos &&
+                          parseIntegerView(arguments.substr(0, space), expectedSize) &&
+                          parseIntegerView(arguments.substr(space + 1), expectedMtime) &&
+                          expectedSize == baseSize && expectedMtime == baseMtime;
+        }
+        if (!baseMatches)
+        {
+            cout << "Journal " << journalPath << " does not belong to the current " << filename << "; discarding it." << endl;
+            file = MappedFile();
+            remove(journalPath.c_str());
+            return;
+        }
+
+        size_t applied = 0;
+        size_t validEnd = pos;
+        while (pos < data.size())
+        {
+            uint64_t length = 0;
+            if (!readJournalHeader(data, pos, op, arguments) || !parseIntegerView(arguments, length) ||
+                length > data.size() - pos || data.size() - pos - length < 1 || data[pos + length] != '\n')
+                break;
+            string_view payload = data.substr(pos, length);
+            pos += length + 1;
+
+            if (op == "insert" || op == "edit")
+            {
+                string lookupTitle;
+                if (op == "edit")
+                {
+                    size_t newline = payload.find('\n');
+                    if (newline == string_view::npos)
+                        break;
+                    lookupTitle.assign(payload.substr(0, newline));
+                    payload.remove_prefix(newline + 1);
+                }
+                vector<Recipe> parsed;
+                parseRecipeText(payload, parsed, symbols, arena);
+                if (parsed.size() == 1)
+                {
+                    if (op == "insert")
+                        applyInsert(std::move(parsed[0]));
+                    else
+                        applyEdit(lookupTitle, std::move(parsed[0]));
+                }
+            }
+            else if (op == "delete")
+            {
+                applyDelete(string(payload));
+            }
+            else if (op == "sort")
+            {
+                applySort();
+            }
+            applied++;
+            validEnd = pos;
+        }
+
+        journalBytes = validEnd;
+        if (validEnd < data.size())
+        {
+            cout << "Journal " << journalPath << " ends with an incomplete record; truncating it." << endl;
+            file = MappedFile();
+            error_code ec;
+            filesystem::resize_file(journalPath, validEnd, ec);
+        }
+        if (applied > 0)
+            cout << "Replayed " << applied << " change(s) from " << journalPath << endl;
+    }
+
+    // 모든 레시피의 id를 난이도별 버킷에 넣습니다. (검색 색인을 만든 뒤 호출)
+    void rebuildDifficultyBuckets()
+    {
+        difficultyBuckets.clear();
+        for (size_t row = 0; row < recipes.size(); row++)
+            difficultyBuckets.insert(searchIndex.idAt(row), recipes[row].getDifficulty());
+    }
+
+    // 로딩이 끝날 때마다 호출: 저널을 새 파일 이름에 맞추고 (켜져 있으면) 다시 적용합니다.
+    void finishLoad()
+    {
+        recipesChanged();
+        searchIndex.rebuild(recipes); // 저널 재적용(수정/삭제)도 색인으로 제목을 찾으므로 먼저 만듭니다.
+        rebuildDifficultyBuckets();
+        columns.rebuild(recipes);
+        journalPath = defaultJournalPath(filename);
+        journalBytes = 0;
+        unjournaledChanges = false;
+        if (journaling)
+            replayJournal();
+    }
+
+    template <typename Integer>
+    static bool parseIntegerView(string_view s, Integer &out)
+    {
+        return from_chars(s.data(), s.data() + s.size(), out).ec == errc();
+    }
+
 public:
     /**
-     * vector<Ingredient> parseIngredients(const string& value): "이름|양|단위,이름|양|단위" 형식의 재료 문자열을 파싱하여 vector<Ingredient> 객체로 변환합니다.
+     * vector<Ingredient> parseIngredients(const string& value, vector<IngredientIssue>* issues): "이름|양|단위,이름|양|단위" 형식의 재료 문자열을 파싱하여 vector<Ingredient> 객체로 변환합니다.
      * param value 파싱할 재료 정보 문자열
-     * details: 먼저 ','를 기준으로 각 재료를 분리하고, 다시 '|'를 기준으로 이름, 양, 단위를 분리하여 Ingredient 객체를 생성합니다.
-     * stod (string to double) 함수를 사용하며, 숫자로 변환할 수 없는 경우를 대비해 try-catch로 예외 처리를 합니다.
+     * param issues 잘못된 항목을 기록할 벡터 (생략 가능). 항목의 뷰는 value를 가리킵니다.
+     * details: parseIngredientList로 줄을 한 번 훑으며 파싱합니다. split/istringstream/stod를 쓰지 않으므로
+     * 항목마다 임시 문자열을 만들지 않고, 숫자로 변환할 수 없는 양도 예외 없이 0으로 처리합니다.
      * return 파싱된 재료 객체들의 벡터
      */
     // Ingredients 문자열을 파싱하여 vector<Ingredient>로 반환
-    vector<Ingredient> parseIngredients(const string& value) {
-        vector<string> ingredientStrings = split(value, ',');
+    vector<Ingredient> parseIngredients(const string& value, vector<IngredientIssue>* issues = nullptr) {
         vector<Ingredient> newIngredients;
-        for (const string& ingStr : ingredientStrings) {
-            vector<string> parts = split(ingStr, '|');
-            if (parts.size() == 3) {
-                Ingredient ing;
-                ing.name = parts[0];
-                try {
-                    ing.quantity = stod(parts[1]);
-                } catch (const std::exception&) {
-                    ing.quantity = 0;
-                }
-                ing.unit = parts[2];
-                newIngredients.push_back(ing);
-            }
-        }
+        parseIngredientList(value, newIngredients, *symbols, issues);
         return newIngredients;
     }
+
+    // 파일을 읽는 중 발견된 잘못된 재료 항목 수를 알려줍니다. (항목별 내용은 너무 많을 수 있으므로 개수만)
+    void warnIngredientIssues(size_t count) const {
+        if (count > 0)
+            cout << "Warning: " << count << " malformed ingredient entries in " << filename << " were skipped or zeroed." << endl;
+    }
+
+    // 사용자 입력에서 발견된 잘못된 재료 항목을 알려줍니다.
+    static void printIngredientIssues(const vector<IngredientIssue>& issues) {
+        for (const auto& issue : issues)
+            cout << "Warning: ingredient '" << issue.entry << "' " << issue.reason << "." << endl;
+    }
     
     
     // --- 파일 입출력 ---
@@ -152,6 +867,7 @@ public:
         ifstream file(filename);
         if (!file.is_open()) return false;
         recipes.clear();
+        resetStorage();
 
         string line, currentTitle, currentProcedure;
         int currentTime = 0;
@@ -162,7 +878,7 @@ public:
         // 람다(lambda) 함수: 현재까지 파싱된 정보로 레시피 객체를 생성하고 벡터에 추가하는 로직을 캡슐화합니다.
         auto createAndStoreRecipe = [&]() {
             if (!currentTitle.empty()) {
-                recipes.emplace_back(currentTitle, trim(currentProcedure), currentTime, currentIngredient, currentDifficulty);
+                recipes.emplace_back(currentTitle, trim(currentProcedure), currentTime, currentIngredient, currentDifficulty, symbols, arena);
                 currentTitle.clear();
                 currentProcedure.clear();
                 currentIngredient.clear();
@@ -206,37 +922,422 @@ public:
         }
         createAndStoreRecipe();
         file.close();
+        finishLoad();
         return true;
     }
 
+    // --- 조리 절차 지연 로딩 ---
+
+    /*
+     * void setLazyProcedures(bool enabled): 조리 절차 지연 로딩을 켜거나 끕니다. (다음 로딩부터 적용)
+     * details: 조리 절차는 가장 큰 필드이지만 display()와 saveToFile()에서만 읽습니다.
+     * 켜 두면 로더는 각 조리 절차의 파일 위치와 길이만 기억하고, getProcedure()가 처음 호출될 때 텍스트를 만듭니다.
+     * 검색, 추천, 식단 계획은 조리 절차를 읽지 않으므로 상주 메모리는 대부분 제목과 재료만 차지합니다.
+     * 매핑된 파일을 계속 사용하므로 loadFromFileMapped, loadFromFileParallel, loadFromSnapshot에만 적용됩니다.
+     */
+    void setLazyProcedures(bool enabled) { lazyProcedures = enabled; }
+    bool isLazyProcedures() const { return lazyProcedures; }
+
+    // 아직 읽지 않은(파일 위치만 기억하는) 조리 절차의 수
+    size_t countUnloadedProcedures() const {
+        return count_if(recipes.begin(), recipes.end(), [](const Recipe& r) { return !r.isProcedureLoaded(); });
+    }
+
+    /*
+     * shared_ptr<ProcedureSource> makeLazySource(MappedFile& file, bool rawText) const: 지연 로딩이 켜져 있으면 매핑을 ProcedureSource로 넘깁니다.
+     * return 지연 로딩이 꺼져 있으면 nullptr (이때 file은 그대로 남습니다)
+     */
+    shared_ptr<ProcedureSource> makeLazySource(MappedFile& file, bool rawText) const {
+        if (!lazyProcedures)
+            return nullptr;
+        return make_shared<ProcedureSource>(std::move(file), rawText);
+    }
+
     /*
-     * bool saveToFile() const: 현재 `recipes` 벡터에 있는 모든 레시피 데이터를 파일에 저장합니다.
+     * bool loadFromFileMapped(const string& filename): loadFromFile과 같은 결과를 만드는 메모리 매핑(mmap) 로더입니다.
+     * param filename 읽어올 파일의 경로 및 이름
+     * details: getline으로 한 줄씩 복사하고 trim/substr로 다시 복사하는 대신, 파일 전체를 매핑한 뒤 string_view 커서로 파싱합니다.
+     * 레시피 파일이 수백 MB로 커져도 시작 시간이 파일 읽기 속도에 가깝게 유지됩니다.
+     * return 파일을 성공적으로 읽어왔으면 true, 실패했으면 false를 반환합니다.
+     */
+    bool loadFromFileMapped(const string& filename) {
+        this->filename = filename;
+        MappedFile file;
+        if (!file.open(filename)) return false;
+        recipes.clear();
+        resetStorage();
+        shared_ptr<ProcedureSource> source = makeLazySource(file, true);
+        TextParseSummary summary = parseRecipeText(source ? source->view() : file.view(), recipes, symbols, arena, source);
+        warnIngredientIssues(summary.ingredientIssues);
+        if (source) source->dropResidentPages();
+        finishLoad();
+        return true;
+    }
+
+    /*
+     * bool loadFromFileParallel(const string& filename, unsigned threadCount = 0): 여러 코어를 사용해 레시피 파일을 읽습니다.
+     * param filename 읽어올 파일의 경로 및 이름
+     * param threadCount 사용할 스레드 수 (0이면 하드웨어 코어 수)
+     * details: 1. 파일을 메모리에 매핑하고 'Recipe name:' 줄 경계에서 조각으로 나눕니다.
+     * 2. 각 조각을 별도 스레드에서 parseRecipeText로 파싱합니다. 조각마다 자기 심볼 표를 쓰므로 스레드끼리 공유하는 상태가 없습니다.
+     * 3. 파일 순서대로 결과를 이어 붙이면서, 앞 레시피의 Time/Grade를 물려받은 레시피의 값을 채워 넣고
+     *    조각의 심볼 표를 데이터베이스 표에 합쳐 재료 id를 바꿉니다.
+     * 결과는 loadFromFile(serial)과 완전히 같습니다. 파일이 작으면 스레드를 만들지 않고 바로 파싱합니다.
+     * return 파일을 성공적으로 읽어왔으면 true, 실패했으면 false를 반환합니다.
+     */
+    bool loadFromFileParallel(const string& filename, unsigned threadCount = 0) {
+        const size_t minChunkBytes = 1 << 20; // 1MB보다 작은 조각은 스레드 생성 비용이 더 큽니다.
+
+        this->filename = filename;
+        MappedFile file;
+        if (!file.open(filename)) return false;
+        recipes.clear();
+        resetStorage();
+
+        shared_ptr<ProcedureSource> source = makeLazySource(file, true);
+        string_view text = source ? source->view() : file.view();
+        if (threadCount == 0)
+            threadCount = max(1u, thread::hardware_concurrency());
+        size_t chunkCount = min<size_t>(threadCount, text.size() / minChunkBytes + 1);
+
+        vector<string_view> chunks = splitAtRecordBoundaries(text, chunkCount);
+        if (chunks.size() == 1) {
+            warnIngredientIssues(parseRecipeText(text, recipes, symbols, arena, source).ingredientIssues);
+            if (source) source->dropResidentPages();
+            finishLoad();
+            return true;
+        }
+
+        vector<vector<Recipe>> parsed(chunks.size());
+        vector<TextParseSummary> summaries(chunks.size());
+        vector<shared_ptr<SymbolTable>> chunkSymbols(chunks.size());
+        vector<shared_ptr<TextArena>> chunkArenas(chunks.size());
+        chunkSymbols[0] = symbols; // 첫 조각은 데이터베이스 표/아레나에 바로 저장
+        chunkArenas[0] = arena;
+        for (size_t i = 1; i < chunks.size(); i++) {
+            chunkSymbols[i] = make_shared<SymbolTable>();
+            chunkArenas[i] = make_shared<TextArena>();
+        }
+        vector<thread> workers;
+        workers.reserve(chunks.size() - 1);
+        for (size_t i = 1; i < chunks.size(); i++) {
+            workers.emplace_back([&, i]() { summaries[i] = parseRecipeText(chunks[i], parsed[i], chunkSymbols[i], chunkArenas[i], source); });
+        }
+        summaries[0] = parseRecipeText(chunks[0], parsed[0], chunkSymbols[0], chunkArenas[0], source); // 첫 조각은 현재 스레드가 처리
+        for (auto &worker : workers)
+            worker.join();
+
+        // 파일 순서대로 병합 (Time/Grade 상속값 보정 포함)
+        size_t total = 0;
+        for (const auto &part : parsed)
+            total += part.size();
+        recipes.reserve(total);
+
+        int carriedTime = 0;
+        Difficulty carriedGrade = Difficulty::A;
+        size_t ingredientIssues = 0;
+        for (size_t i = 0; i < parsed.size(); i++) {
+            const TextParseSummary &summary = summaries[i];
+            ingredientIssues += summary.ingredientIssues;
+            for (size_t j = 0; j < summary.timeInherited && j < parsed[i].size(); j++)
+                parsed[i][j].setTime(carriedTime);
+            for (size_t j = 0; j < summary.gradeInherited && j < parsed[i].size(); j++)
+                parsed[i][j].setDifficulty(carriedGrade);
+            if (summary.timeSeen)
+                carriedTime = summary.lastTime;
+            if (summary.gradeSeen)
+                carriedGrade = summary.lastGrade;
+            if (i > 0) {
+                // 조각의 심볼은 id를 바꾸고, 조각의 아레나 블록은 복사 없이 데이터베이스 아레나로 넘깁니다.
+                vector<uint32_t> remap = symbols->merge(*chunkSymbols[i]);
+                arena->absorb(*chunkArenas[i]);
+                for (auto &recipe : parsed[i]) {
+                    recipe.rebindSymbols(symbols, remap);
+                    recipe.rebindArena(arena);
+                }
+                chunkSymbols[i].reset();
+                chunkArenas[i].reset();
+            }
+
+            move(parsed[i].begin(), parsed[i].end(), back_inserter(recipes));
+            vector<Recipe>().swap(parsed[i]); // 병합한 조각의 메모리는 바로 반환
+        }
+        warnIngredientIssues(ingredientIssues);
+        if (source) source->dropResidentPages();
+        finishLoad();
+        return true;
+    }
+
+    // --- 바이너리 스냅샷 ---
+
+    /*
+     * static bool textSourceInfo(const string& textPath, uint64_t& size, int64_t& mtime): 텍스트 파일의 크기와 수정 시각을 가져옵니다.
+     * details: 스냅샷 헤더에 기록해 두었다가, 시작할 때 현재 텍스트 파일과 비교하여 오래된 스냅샷을 걸러냅니다.
+     */
+    static bool textSourceInfo(const string& textPath, uint64_t& size, int64_t& mtime) {
+        error_code ec;
+        size = filesystem::file_size(textPath, ec);
+        if (ec) return false;
+        auto writeTime = filesystem::last_write_time(textPath, ec);
+        if (ec) return false;
+        mtime = static_cast<int64_t>(writeTime.time_since_epoch().count());
+        return true;
+    }
+
+    // "Recipe.txt" -> "Recipe.snap" 처럼 텍스트 파일 이름에 대응하는 기본 스냅샷 파일 이름을 만듭니다.
+    static string defaultSnapshotPath(const string& textPath) {
+        const string ext = ".txt";
+        if (textPath.size() > ext.size() && textPath.compare(textPath.size() - ext.size(), ext.size(), ext) == 0)
+            return textPath.substr(0, textPath.size() - ext.size()) + ".snap";
+        return textPath + ".snap";
+    }
+
+    /*
+     * static bool isSnapshotFresh(const string& snapshotPath, const string& textPath): 스냅샷이 현재 텍스트 파일로부터 만들어졌는지 확인합니다.
+     * return 스냅샷 헤더의 원본 크기/수정 시각이 텍스트 파일과 같으면 true
+     */
+    static bool isSnapshotFresh(const string& snapshotPath, const string& textPath) {
+        uint64_t snapSize = 0, textSize = 0;
+        int64_t snapMtime = 0, textMtime = 0;
+        return RecipeSnapshot::readSourceInfo(snapshotPath, snapSize, snapMtime) &&
+               textSourceInfo(textPath, textSize, textMtime) &&
+               snapSize == textSize && snapMtime == textMtime;
+    }
+
+    /*
+     * bool loadFromSnapshot(const string& snapshotPath, const string& textFilename): 바이너리 스냅샷에서 레시피를 읽어옵니다.
+     * param snapshotPath 스냅샷 파일 경로
+     * param textFilename 이후 saveToFile()이 저장할 텍스트 파일 경로 (교환 형식은 항상 텍스트입니다)
+     * details: 토큰 분리나 숫자 변환 없이 고정 크기 레코드를 그대로 읽으므로 텍스트 파싱보다 훨씬 빠릅니다.
+     * return 성공 시 true, 스냅샷이 없거나 손상되었으면 false (이때 기존 데이터는 그대로 유지됩니다)
+     */
+    bool loadFromSnapshot(const string& snapshotPath, const string& textFilename) {
+        vector<Recipe> loaded;
+        string error;
+        auto loadedSymbols = make_shared<SymbolTable>();
+        auto loadedArena = make_shared<TextArena>();
+        if (!RecipeSnapshot::read(snapshotPath, loaded, error, loadedSymbols, loadedArena, lazyProcedures)) {
+            cout << "Snapshot " << snapshotPath << " not loaded: " << error << endl;
+            return false;
+        }
+        this->filename = textFilename;
+        recipes = std::move(loaded);
+        symbols = std::move(loadedSymbols);
+        arenaPeakBytes = max(arenaPeakBytes, arena->getPeakReservedBytes());
+        arena = std::move(loadedArena);
+        finishLoad();
+        return true;
+    }
+
+    /*
+     * static bool convertTextToSnapshot(const string& textPath, const string& snapshotPath): 텍스트 레시피 파일을 바이너리 스냅샷으로 변환합니다.
+     * details: 메모리의 (저장되지 않았을 수도 있는) 데이터가 아니라 파일을 직접 읽어 변환하므로, 헤더의 원본 정보와 내용이 항상 일치합니다.
+     */
+    static bool convertTextToSnapshot(const string& textPath, const string& snapshotPath) {
+        RecipeDatabase source;
+        uint64_t size = 0;
+        int64_t mtime = 0;
+        if (!textSourceInfo(textPath, size, mtime) || !source.loadFromFileParallel(textPath)) {
+            cout << "Cannot read " << textPath << endl;
+            return false;
+        }
+        if (!RecipeSnapshot::write(snapshotPath, source.recipes, size, mtime)) {
+            cout << "Cannot write " << snapshotPath << endl;
+            return false;
+        }
+        cout << "Converted " << source.recipes.size() << " recipe(s): " << textPath << " -> " << snapshotPath << endl;
+        return true;
+    }
+
+    /*
+     * bool saveSnapshot(const string& snapshotPath) const: 메모리의 레시피로 스냅샷을 다시 만듭니다.
+     * details: 헤더에는 현재 텍스트 파일의 크기/수정 시각을 기록하므로, 반드시 saveToFile() 직후(메모리와 파일 내용이 같을 때) 호출해야 합니다.
+     * 저널에만 기록된 변경이 남아 있으면 스냅샷을 만들지 않습니다. (다음 시작 때 저널이 두 번 적용되는 것을 막기 위해)
+     * 종료 시 저장하면서 스냅샷도 함께 갱신해 두면, 다음 시작 때 스냅샷이 오래된 것으로 처리되지 않습니다.
+     */
+    bool saveSnapshot(const string& snapshotPath) const {
+        if (journalBytes > 0 || unjournaledChanges)
+            return false; // 메모리 내용이 기본 텍스트 파일과 다름 (저널에만 있는 변경이 있음)
+        uint64_t size = 0;
+        int64_t mtime = 0;
+        return textSourceInfo(filename, size, mtime) && RecipeSnapshot::write(snapshotPath, recipes, size, mtime, syncPolicy);
+    }
+
+    // 바이너리 스냅샷을 텍스트 레시피 파일로 되돌립니다. (saveToFile과 같은 형식)
+    static bool convertSnapshotToText(const string& snapshotPath, const string& textPath) {
+        RecipeDatabase source;
+        if (!source.loadFromSnapshot(snapshotPath, textPath))
+            return false;
+        if (!source.saveToFile()) {
+            cout << "Cannot write " << textPath << endl;
+            return false;
+        }
+        cout << "Converted " << source.recipes.size() << " recipe(s): " << snapshotPath << " -> " << textPath << endl;
+        return true;
+    }
+
+    /*
+     * static bool verifySnapshot(const string& snapshotPath, const string& textPath): 스냅샷의 내용이 텍스트 파일과 같은지 필드 단위로 검사합니다.
+     * details: 텍스트 파일을 새로 파싱한 결과와 스냅샷을 읽은 결과를 레시피 순서대로 비교하고, 첫 번째 차이를 출력합니다.
+     * return 모두 같으면 true
+     */
+    static bool verifySnapshot(const string& snapshotPath, const string& textPath) {
+        RecipeDatabase text, snapshot;
+        if (!text.loadFromFileParallel(textPath)) {
+            cout << "Cannot read " << textPath << endl;
+            return false;
+        }
+        if (!snapshot.loadFromSnapshot(snapshotPath, textPath))
+            return false;
+
+        if (text.recipes.size() != snapshot.recipes.size()) {
+            cout << "Mismatch: " << textPath << " has " << text.recipes.size() << " recipe(s), snapshot has "
+                 << snapshot.recipes.size() << endl;
+            return false;
+        }
+        for (size_t i = 0; i < text.recipes.size(); i++) {
+            const Recipe& a = text.recipes[i];
+            const Recipe& b = snapshot.recipes[i];
+            string field;
+            if (a.getTitle() != b.getTitle()) field = "title";
+            else if (a.getProcedure() != b.getProcedure()) field = "procedure";
+            else if (a.getTime() != b.getTime()) field = "time";
+            else if (a.getDifficulty() != b.getDifficulty()) field = "grade";
+            else if (a.getIngredient().size() != b.getIngredient().size()) field = "ingredient count";
+            else {
+                for (size_t j = 0; j < a.getIngredient().size() && field.empty(); j++) {
+                    const Ingredient& x = a.getIngredient()[j];
+                    const Ingredient& y = b.getIngredient()[j];
+                    // 두 데이터베이스는 서로 다른 심볼 표를 쓰므로 id가 아니라 문자열을 비교
+                    if (a.ingredientName(x) != b.ingredientName(y) || x.quantity != y.quantity || a.ingredientUnit(x) != b.ingredientUnit(y))
+                        field = "ingredient #" + to_string(j + 1);
+                }
+            }
+            if (!field.empty()) {
+                cout << "Mismatch in recipe #" << (i + 1) << " '" << a.getTitle() << "': " << field << " differs." << endl;
+                return false;
+            }
+        }
+        if (!isSnapshotFresh(snapshotPath, textPath))
+            cout << "Note: contents match, but the snapshot was built from an older copy of " << textPath << "." << endl;
+        cout << "Snapshot OK: " << text.recipes.size() << " recipe(s) match " << textPath << "." << endl;
+        return true;
+    }
+
+    // 현재 데이터베이스가 저장되는 텍스트 파일 이름
+    const string& getFilename() const { return filename; }
+
+    /*
+     * bool saveToFile(): 현재 `recipes` 벡터에 있는 모든 레시피 데이터를 파일에 저장합니다.
+     * details: 먼저 전체 데이터베이스를 메모리 버퍼 하나로 직렬화한 뒤, AtomicFile로 임시 파일(filename.tmp)에 큰 write 몇 번으로 쓰고
+     * 동기화 정책(syncPolicy)에 따라 fsync한 다음 rename으로 원본을 교체합니다.
+     * 저장 도중 프로그램이 죽어도 원본은 이전 내용 그대로 남고, 원본을 매핑해 읽는 지연 로딩 레시피도 안전합니다.
+     * 쓴 바이트 수와 걸린 시간은 getLastSaveReport() / printLastSaveReport()로 확인할 수 있습니다.
+     * 저널을 사용 중이면 모든 변경이 기본 파일에 들어갔으므로 저널을 비웁니다.
      * return 파일 저장 성공 시 true, 실패 시 false
      */
     
     // 'Grade' 형식으로 저장하는 함수
-    bool saveToFile() const {
-        ofstream file(filename);
-        if (!file.is_open()) return false;
-        for (const auto& recipe : recipes) {
-            file << "Recipe name: " << recipe.getTitle() << "\n";
-            file << "Recipe Procedure:\n" << recipe.getProcedure() << "\n";
-            file << "Time: " << recipe.getTime() << "\n";
-            
-            file << "Ingredients: ";
-            const auto& ingredients = recipe.getIngredient();
-            for (size_t j = 0; j < ingredients.size(); ++j) {
-                const auto& ing = ingredients[j];
-                file << ing.name << "|" << ing.quantity << "|" << ing.unit;
-                if (j < ingredients.size() - 1) file << ", ";
-            }
-            file << "\n";
-            file << "Grade: " << difficultyToString(recipe.getDifficulty()) << "\n\n";
-        }
-        file.close();
+    bool saveToFile() {
+        auto start = chrono::steady_clock::now();
+        string buffer;
+        buffer.reserve(lastSave.bytes + lastSave.bytes / 8 + 4096); // 지난번 크기를 기준으로 재할당을 줄임
+        for (const auto& recipe : recipes)
+            appendRecipeText(buffer, recipe);
+        double serializeSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        AtomicWriteResult written = AtomicFile::write(filename, {buffer}, syncPolicy);
+        lastSave.ok = written.ok;
+        lastSave.bytes = written.bytes;
+        lastSave.serializeSeconds = serializeSeconds;
+        lastSave.writeSeconds = written.seconds;
+        lastSave.error = written.error;
+        if (!written.ok)
+            return false;
+        clearJournal();
         return true;
     }
 
+    // 저장 시 fsync 정책 (None / File / FileAndDirectory)
+    void setSyncPolicy(SyncPolicy policy) { syncPolicy = policy; }
+    SyncPolicy getSyncPolicy() const { return syncPolicy; }
+    const SaveReport& getLastSaveReport() const { return lastSave; }
+
+    // 마지막 저장 결과를 한 줄로 출력합니다. 예: "Saved 1234 bytes to Recipe.txt in 1.20 ms (serialize 0.30 ms, write+sync 0.90 ms, sync: file+directory)"
+    void printLastSaveReport() const {
+        if (!lastSave.ok) {
+            cout << "Save to " << filename << " failed: " << lastSave.error << endl;
+            return;
+        }
+        char timing[128];
+        snprintf(timing, sizeof(timing), "%.2f ms (serialize %.2f ms, write+sync %.2f ms",
+                 (lastSave.serializeSeconds + lastSave.writeSeconds) * 1000.0,
+                 lastSave.serializeSeconds * 1000.0, lastSave.writeSeconds * 1000.0);
+        cout << "Saved " << lastSave.bytes << " bytes to " << filename << " in " << timing
+             << ", sync: " << syncPolicyToString(syncPolicy) << ")" << endl;
+    }
+
+    // --- 변경 저널 (append-only) ---
+
+    /*
+     * void setJournaling(bool enabled): 변경 저널을 켜거나 끕니다. (다음 로딩부터 적용)
+     * details: 켜 두면 insertRecipe/editRecipe/deleteRecipe/sortRecipe가 변경 내용을 저널 파일(Recipe.journal) 끝에 바로 덧붙이고,
+     * 로딩할 때 기본 파일 위에 저널을 다시 적용합니다. 따라서 save()의 비용은 데이터베이스 크기가 아니라 변경 횟수에 비례합니다.
+     *
+     * 저널 형식 (텍스트, 레코드마다 길이를 앞에 적어 중간에 끊긴 레코드를 알아낼 수 있음):
+     *   @base <기본 파일 크기> <수정 시각>      첫 줄: 이 저널이 어느 기본 파일 위에 쌓인 것인지
+     *   @insert <n>\n<레시피 텍스트>\n
+     *   @edit <n>\n<찾은 제목>\n<수정된 레시피 텍스트>\n
+     *   @delete <n>\n<제목>\n
+     *   @sort 0\n\n
+     */
+    void setJournaling(bool enabled) { journaling = enabled; }
+    void setJournalCompactThreshold(uint64_t bytes) { journalCompactThreshold = bytes; }
+    uint64_t getJournalBytes() const { return journalBytes; }
+
+    // "Recipe.txt" -> "Recipe.journal"
+    static string defaultJournalPath(const string& textPath) {
+        const string ext = ".txt";
+        if (textPath.size() > ext.size() && textPath.compare(textPath.size() - ext.size(), ext.size(), ext) == 0)
+            return textPath.substr(0, textPath.size() - ext.size()) + ".journal";
+        return textPath + ".journal";
+    }
+
+    /*
+     * bool save(): 저널을 고려한 저장 함수입니다. (Save and Exit에서 사용)
+     * details: 저널이 꺼져 있으면 saveToFile()과 같습니다. 켜져 있으면 변경 내용은 이미 저널에 있으므로 아무것도 쓰지 않고,
+     * 저널이 임계값을 넘었거나 저널에 기록하지 못한 변경이 있을 때만 기본 파일로 합칩니다(compactJournal).
+     * return 변경 내용이 모두 디스크에 있으면 true
+     */
+    bool save() {
+        if (!journaling) {
+            bool ok = saveToFile();
+            printLastSaveReport();
+            return ok;
+        }
+        if (!unjournaledChanges && journalBytes < journalCompactThreshold) {
+            if (journalBytes > 0)
+                cout << "Changes are already in the journal (" << journalBytes << " bytes)." << endl;
+            return true;
+        }
+        return compactJournal();
+    }
+
+    /*
+     * bool compactJournal(): 저널을 기본 파일에 합칩니다.
+     * details: 전체 데이터베이스를 기본 파일로 다시 쓴 뒤 저널을 삭제합니다.
+     * 두 단계 사이에 프로그램이 죽더라도, 남은 저널의 @base 정보가 새 기본 파일과 달라 다음 로딩 때 버려지므로 변경이 두 번 적용되지 않습니다.
+     */
+    bool compactJournal() {
+        uint64_t folded = journalBytes;
+        if (!saveToFile()) {
+            cout << "Journal compaction failed: " << lastSave.error << endl;
+            return false;
+        }
+        cout << "Journal compacted into " << filename << " (" << folded << " journal bytes folded)." << endl;
+        printLastSaveReport();
+        return true;
+    }
 
     // --- 5대 핵심 기능 ---
 
@@ -260,57 +1361,274 @@ public:
         cout << "Enter grade (A, B, C): ";
         getline(cin, gradeStr);
 
-        recipes.emplace_back(
+        vector<IngredientIssue> ingredientIssues;
+        applyInsert(Recipe(
             title, 
             procedure, 
             stoi(timeStr), 
-            parseIngredients(ingredientsLine), // parseIngredients 헬퍼 사용
-            stringToDifficulty(gradeStr)
-        );
+            parseIngredients(ingredientsLine, &ingredientIssues), // parseIngredients 헬퍼 사용
+            stringToDifficulty(gradeStr),
+            symbols,
+            arena
+        ));
+        if (journaling) {
+            string payload;
+            appendRecipeText(payload, recipes.back());
+            appendJournal("insert", payload);
+        }
+        printIngredientIssues(ingredientIssues);
         cout << "\nRecipe '" << title << "' added successfully!" << endl;
     }
 
     /*
-     * void searchRecipe() const: 사용자로부터 키워드를 입력받아 레시피 제목 또는 재료 이름에 해당 키워드가 포함된 모든 레시피를 검색하고 출력합니다.
-     * details: 대소문자를 구분하지 않고 검색하기 위해 toLower 헬퍼 함수를 사용합니다.
+     * void searchRecipe() const: 사용자로부터 키워드를 입력받아 레시피 제목 또는 재료 이름에 해당 키워드가 포함된 레시피를 검색하고 출력합니다.
+     * details: 대소문자를 구분하지 않습니다. 결과는 순위(searchRanked) 순서로 한 페이지(kSearchPageSize개)씩 출력하고,
+     *          다음 페이지를 볼지 묻습니다. 일치하는 레시피가 많아도 한 번에 출력하는 양은 한 페이지입니다.
      */
     void searchRecipe() const {
         cout << "Enter keyword to search for (case-insensitive): ";
         string keyword;
         getline(cin, keyword);
-        string lowerKeyword = toLower(keyword);
 
-        bool foundAny = false;
         cout << "\n--- Search Results ---\n";
+        size_t offset = 0;
+        while (true) {
+            SearchPage page = searchRanked(keyword, offset, kSearchPageSize);
+            if (page.totalMatches == 0) {
+                cout << "No recipes found matching '" << keyword << "'.\n";
+                return;
+            }
+            for (const SearchHit &hit : page.hits)
+                recipes[hit.row].display();
+            offset += page.hits.size();
+            cout << "(Showing " << offset << " of " << page.totalMatches << " matches, best first)\n";
+            if (offset >= page.totalMatches)
+                return;
+            cout << "Show next " << min(kSearchPageSize, page.totalMatches - offset) << "? (y/n): ";
+            string answer;
+            if (!getline(cin, answer) || (answer != "y" && answer != "Y"))
+                return;
+        }
+    }
 
-        for (const auto& recipe : recipes) {
-            // string::npos: find 함수가 문자열을 찾지 못했을 때 반환하는 특별한 값
-            bool foundInThisRecipe = (toLower(recipe.getTitle()).find(lowerKeyword) != string::npos);
+    /*
+     * SearchPage searchRanked(string_view keyword, size_t offset, size_t limit) const: 검색 결과를 순위대로 정렬했을 때 offset번째부터 limit개를 반환합니다.
+     * details: 제목 일치가 재료 일치보다 앞이고, 전체/앞부분/단어 시작 일치가 더 앞입니다. (RecipeSearchIndex::searchRanked)
+     *          offset + limit개만 골라 정렬하므로, 일치하는 레시피 수가 많아도 정렬/출력 비용은 페이지 크기에 비례합니다.
+     * return 행 번호와 점수 목록, 전체 일치 개수
+     */
+    SearchPage searchRanked(string_view keyword, size_t offset, size_t limit) const {
+        return getSearchIndex().searchRanked(keyword, recipes, getColumns(), offset, limit);
+    }
 
-            if (!foundInThisRecipe) {
-                for (const auto& ingredient : recipe.getIngredient()) {
-                    if (toLower(ingredient.name).find(lowerKeyword) != string::npos) {
-                        foundInThisRecipe = true;
-                        break; // 재료에서 찾았으면 더 이상 탐색할 필요 없음
-                    }
+    /*
+     * vector<uint32_t> findRecipes(string_view keyword) const: 제목 또는 재료 이름에 keyword가 (대소문자 구분 없이) 들어 있는 레시피의 행 번호를 반환합니다.
+     * details: 열 저장소는 변경 때 바뀐 행만 고쳐 두므로 getColumns()는 비용이 없습니다. 열(이어 붙인 제목)은 단어 문자가 없는 검색어일 때만 훑습니다.
+     * return getRecipes()의 인덱스, 오름차순
+     */
+    vector<uint32_t> findRecipes(string_view keyword) const {
+        return getSearchIndex().search(keyword, recipes, getColumns());
+    }
+
+    /*
+     * RecipeQueryResult queryRecipes(const RecipeQuery &query) const: 질의의 모든 조건을 만족하는 레시피를 찾습니다.
+     * details: 조건마다 행 번호 비트맵을 만들어 좁은 것부터 합칩니다.
+     *   1. 포함할 재료: 재료 색인의 posting list로 만든 비트맵끼리 교집합 (보통 가장 좁으므로 먼저)
+     *   2. 난이도 / 시간: 후보가 전체의 1/16보다 적으면 후보 행만 직접 확인하고, 아니면 난이도 목록 / 시간 열로 비트맵을 만들어 교집합
+     *   3. 제외할 재료: 재료 비트맵을 차집합
+     * 후보가 비면 남은 조건은 계산하지 않습니다.
+     * return 행 번호 비트맵을 담은 결과. 제목은 반복할 때만 꺼냅니다.
+     */
+    RecipeQueryResult queryRecipes(const RecipeQuery &query) const
+    {
+        uint32_t rowCount = static_cast<uint32_t>(recipes.size());
+        RowBitmap candidates;
+        bool narrowed = false; // false면 후보는 "전체 행"
+
+        for (const string &name : query.getRequiredIngredients())
+        {
+            RowBitmap rows = RowBitmap::fromRows(searchIndex.rowsWithIngredient(name));
+            if (narrowed)
+                candidates.intersectWith(rows);
+            else
+                candidates = std::move(rows);
+            narrowed = true;
+            if (candidates.empty())
+                return RecipeQueryResult(std::move(candidates), &recipes);
+        }
+
+        // 후보가 적으면 남은 후보만 직접 확인하는 편이 비트맵을 새로 만드는 것보다 싸다
+        auto fewCandidates = [&]() { return narrowed && candidates.count() * 16 < rowCount; };
+        auto keepCandidates = [&](auto keep) {
+            vector<uint32_t> kept;
+            candidates.forEach([&](uint32_t row) {
+                if (keep(recipes[row]))
+                    kept.push_back(row);
+            });
+            candidates = RowBitmap::fromSortedRows(kept);
+        };
+        auto narrowTo = [&](RowBitmap rows) {
+            if (narrowed)
+                candidates.intersectWith(rows);
+            else
+                candidates = std::move(rows);
+            narrowed = true;
+        };
+
+        if (query.restrictsDifficulty())
+        {
+            if (fewCandidates())
+                keepCandidates([&](const Recipe &r) { return query.allowsDifficulty(r.getDifficulty()); });
+            else
+            {
+                RowBitmap rows;
+                for (Difficulty d : {Difficulty::A, Difficulty::B, Difficulty::C})
+                {
+                    if (query.allowsDifficulty(d))
+                        rows.uniteWith(RowBitmap::fromSortedRows(getRowsByDifficulty(d).sortedRows()));
                 }
+                narrowTo(std::move(rows));
             }
+        }
 
-            if (foundInThisRecipe) {
-                recipe.display();
-                foundAny = true;
+        if (query.restrictsTime())
+        {
+            if (fewCandidates())
+                keepCandidates([&](const Recipe &r) { return query.allowsTime(r.getTime()); });
+            else
+            {
+                // 시간 열(연속된 int 배열)만 순서대로 훑음
+                const RecipeColumns &cols = getColumns();
+                vector<uint32_t> rows;
+                for (uint32_t row = 0; row < rowCount; row++)
+                {
+                    if (query.allowsTime(cols.timeAt(row)))
+                        rows.push_back(row);
+                }
+                narrowTo(RowBitmap::fromSortedRows(rows));
             }
         }
-        if (!foundAny) {
-            cout << "No recipes found matching '" << keyword << "'.\n";
+
+        if (!narrowed)
+            candidates = RowBitmap::allRows(rowCount);
+        for (const string &name : query.getExcludedIngredients())
+        {
+            if (candidates.empty())
+                break;
+            candidates.subtract(RowBitmap::fromRows(searchIndex.rowsWithIngredient(name)));
+        }
+        return RecipeQueryResult(std::move(candidates), &recipes);
+    }
+
+    // 질의 결과의 개수만 셉니다. (제목/레시피를 꺼내지 않음)
+    size_t countRecipes(const RecipeQuery &query) const {
+        return queryRecipes(query).count();
+    }
+
+    /*
+     * vector<PantryMatch> findCookableRecipes(const vector<string> &onHand, uint32_t maxMissing) const:
+     * 가진 재료(onHand)로 재료가 maxMissing개 이하만 부족한 레시피를 찾습니다. (0이면 재료를 모두 가진 레시피만)
+     * details: 재료 이름은 대소문자를 구분하지 않고 정확히 같아야 합니다. 재료 목록이 비어 있는 레시피는 제외합니다.
+     *          레시피마다 재료 비트 집합과 가진 재료 비트 집합을 64비트 워드 단위로 AND/popcount하므로 문자열을 비교하지 않습니다.
+     * return 부족한 재료가 적은 순서 (같으면 행 번호 순서)
+     */
+    vector<PantryMatch> findCookableRecipes(const vector<string> &onHand, uint32_t maxMissing) const {
+        return findCookableRecipes(getPantryIndex().makePantry(onHand), maxMissing);
+    }
+
+    // 이미 만든 가진 재료 비트 집합(getPantryIndex().makePantry)으로 찾습니다. 부족한 재료를 다시 출력할 때처럼 pantry를 계속 쓸 때 사용합니다.
+    vector<PantryMatch> findCookableRecipes(const PantryIndex::Pantry &pantry, uint32_t maxMissing) const {
+        const PantryIndex &index = getPantryIndex();
+        vector<PantryMatch> matches;
+        index.forEachCookable(pantry, maxMissing, [&](uint32_t row, uint32_t missing) {
+            matches.push_back({row, missing});
+        });
+        stable_sort(matches.begin(), matches.end(), [](const PantryMatch &a, const PantryMatch &b) {
+            return a.missing < b.missing;
+        });
+        return matches;
+    }
+
+    /*
+     * void cookFromPantry() const: 사용자로부터 가진 재료와 부족해도 되는 재료 수를 입력받아 만들 수 있는 레시피를 출력합니다.
+     * details: 부족한 재료가 적은 순서로 한 페이지(kSearchPageSize개)씩 제목과 부족한 재료를 출력하고, 다음 페이지를 볼지 묻습니다.
+     */
+    void cookFromPantry() const {
+        cout << "Enter ingredients you have (comma separated, e.g., egg, flour, milk): ";
+        string line;
+        getline(cin, line);
+        vector<string> onHand;
+        size_t start = 0;
+        while (start <= line.size()) {
+            size_t comma = line.find(',', start);
+            if (comma == string::npos)
+                comma = line.size();
+            string name = trim(line.substr(start, comma - start));
+            if (name.find_first_not_of(" \t\n\r") != string::npos)
+                onHand.push_back(std::move(name));
+            start = comma + 1;
+        }
+        if (onHand.empty()) {
+            cout << "No ingredients entered.\n";
+            return;
+        }
+
+        cout << "How many missing ingredients are allowed? (0 = have everything): ";
+        string countStr;
+        getline(cin, countStr);
+        uint32_t maxMissing = 0;
+        try {
+            int value = stoi(countStr);
+            maxMissing = value > 0 ? static_cast<uint32_t>(value) : 0;
+        } catch (...) {
+            cout << "Invalid number. Showing recipes with nothing missing.\n";
+        }
+
+        const PantryIndex &index = getPantryIndex();
+        PantryIndex::Pantry pantry = index.makePantry(onHand);
+        if (pantry.unknownCount() > 0)
+            cout << pantry.unknownCount() << " of the entered ingredients are not used by any recipe.\n";
+        vector<PantryMatch> matches = findCookableRecipes(pantry, maxMissing);
+
+        cout << "\n--- Recipes You Can Cook ---\n";
+        if (matches.empty()) {
+            cout << "No recipes found with at most " << maxMissing << " missing ingredient(s).\n";
+            return;
+        }
+        const RecipeColumns &cols = getColumns();
+        size_t offset = 0;
+        while (true) {
+            size_t end = min(offset + kSearchPageSize, matches.size());
+            for (; offset < end; offset++) {
+                const PantryMatch &match = matches[offset];
+                cout << "- " << cols.titleAt(match.row);
+                if (match.missing == 0) {
+                    cout << " (all ingredients on hand)\n";
+                    continue;
+                }
+                cout << " (missing: ";
+                bool first = true;
+                index.forEachMissing(match.row, pantry, [&](string_view name) {
+                    cout << (first ? "" : ", ") << name;
+                    first = false;
+                });
+                cout << ")\n";
+            }
+            cout << "(Showing " << offset << " of " << matches.size() << " recipes, fewest missing first)\n";
+            if (offset >= matches.size())
+                return;
+            cout << "Show next " << min(kSearchPageSize, matches.size() - offset) << "? (y/n): ";
+            string answer;
+            if (!getline(cin, answer) || (answer != "y" && answer != "Y"))
+                return;
         }
     }
 
     /*
      * void deleteRecipe(): 사용자로부터 제목을 입력받아 일치하는 레시피를 데이터베이스에서 삭제합니다.
-     * details: C++의 'Erase-Remove Idiom'을 사용합니다.
-     * 1. remove_if: 삭제할 조건에 맞는 원소들을 벡터의 뒤쪽으로 모두 옮기고, 유효한 원소들의 끝을 가리키는 반복자(iterator)를 반환합니다. (실제 삭제는 아님)
-     * 2. erase: remove_if가 반환한 위치부터 벡터의 실제 끝까지의 원소들을 한 번에 삭제합니다.
+     * details: applyDelete로 삭제하고, 성공하면 저널에 기록합니다.
+     * 1. 제목 해시 색인에서 제목이 정확히 같은 레시피의 행 번호를 바로 찾습니다. (전체 목록을 훑지 않음)
+     * 2. 첫 삭제 위치부터 뒤쪽 레시피를 한 번만 앞으로 당겨 빈 자리를 메우고, 열 저장소와 색인도 같은 행만 지웁니다.
      */
     void deleteRecipe()
     {
@@ -318,13 +1636,10 @@ public:
         string title;
         getline(cin, title);
 
-        // 람다 함수 `[&](...) { ... }`: 삭제할 조건을 정의하는 함수 객체를 즉석에서 만듭니다. `[&]`는 외부 변수(title)를 참조로 캡처합니다.
-        auto it = remove_if(recipes.begin(), recipes.end(), [&](const Recipe &recipe)
-                            { return recipe.getTitle() == title; });
-
-        if (it != recipes.end())
+        // applyDelete: 제목 해시 색인으로 지울 레시피를 찾아 삭제합니다.
+        if (applyDelete(title))
         {
-            recipes.erase(it, recipes.end());
+            appendJournal("delete", title);
             cout << "Recipe '" << title << "' deleted successfully." << endl;
         }
         else
@@ -339,8 +1654,8 @@ public:
      */
     void sortRecipe()
     {
-        sort(recipes.begin(), recipes.end(), [](const Recipe &a, const Recipe &b)
-             { return a.getTitle() < b.getTitle(); });
+        applySort();
+        appendJournal("sort", "");
         cout << "Recipes have been sorted by title." << endl;
     }
 
@@ -354,74 +1669,91 @@ public:
     cout << "Enter title of the recipe to edit: ";
     string title;
     getline(cin, title);
+    string titleKey = Recipe::foldKey(title); // 입력은 한 번만 소문자로 바꾸고, 레시피 쪽은 미리 만든 키와 비교
 
-    for (auto &recipe : recipes)
+    vector<uint32_t> rows = searchIndex.rowsWithTitleKey(titleKey, recipes); // 제목 해시 색인으로 대소문자 구분 없이 검색
+    if (!rows.empty())
     {
-        if (toLower(recipe.getTitle()) == toLower(title)) // 대소문자 구분 없이 검색
+        size_t row = rows[0]; // 같은 제목이 여러 개면 목록에서 가장 앞의 레시피
+        Recipe &recipe = recipes[row];
+        searchIndex.beforeEdit(row, recipe); // 바뀌기 전의 제목/재료를 색인에서 뺌
+        Difficulty before = recipe.getDifficulty();
+        cout << "Recipe found. Which part do you want to edit?" << endl;
+        cout << "1. Title\n2. Procedure\n3. Time\n4. Ingredients\n5. Grade\n> ";
+        int choice;
+        cin >> choice;
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
+        switch (choice)
         {
-            cout << "Recipe found. Which part do you want to edit?" << endl;
-            cout << "1. Title\n2. Procedure\n3. Time\n4. Ingredients\n5. Grade\n> ";
-            int choice;
-            cin >> choice;
-            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        case 1: {
+            cout << "Enter new title: ";
+            string input;
+            getline(cin, input);
+            recipe.setTitle(input);
+            break;
+        }
 
-            switch (choice)
+        case 2: {
+            cout << "Enter new procedure (end with an empty line):\n";
+            string newProcedure;
+            string proc_line;
+            while (getline(cin, proc_line) && !proc_line.empty())
             {
-            case 1: {
-                cout << "Enter new title: ";
-                string input;
-                getline(cin, input);
-                recipe.setTitle(input);
-                break;
-            }
-
-            case 2: {
-                cout << "Enter new procedure (end with an empty line):\n";
-                string newProcedure;
-                string proc_line;
-                while (getline(cin, proc_line) && !proc_line.empty())
-                {
-                    newProcedure += proc_line + "\n";
-                }
-                recipe.setProcedure(trim(newProcedure)); // 끝에 불필요한 공백 제거
-                break;
+                newProcedure += proc_line + "\n";
             }
+            recipe.setProcedure(trim(newProcedure)); // 끝에 불필요한 공백 제거
+            break;
+        }
 
-            case 3: {
-                cout << "Enter new time (minutes): ";
-                string input;
-                getline(cin, input);
-                try {
-                    recipe.setTime(stoi(input)); // 문자열을 숫자로 변환
-                } catch (const std::exception& e) {
-                    cout << "Invalid number format. Time not updated." << endl;
-                }
-                break;
+        case 3: {
+            cout << "Enter new time (minutes): ";
+            string input;
+            getline(cin, input);
+            try {
+                recipe.setTime(stoi(input)); // 문자열을 숫자로 변환
+            } catch (const std::exception& e) {
+                cout << "Invalid number format. Time not updated." << endl;
             }
+            break;
+        }
 
-            case 4: {
-                cout << "Enter new ingredients (e.g., flour|1|cup, egg|2|ea): ";
-                string input;
-                getline(cin, input);
-                recipe.setIngredient(parseIngredients(input));
-                break;
-            }
+        case 4: {
+            cout << "Enter new ingredients (e.g., flour|1|cup, egg|2|ea): ";
+            string input;
+            getline(cin, input);
+            vector<IngredientIssue> ingredientIssues;
+            recipe.setIngredient(parseIngredients(input, &ingredientIssues));
+            printIngredientIssues(ingredientIssues);
+            break;
+        }
 
-            case 5: {
-                cout << "Enter new grade (A, B, C): ";
-                string input;
-                getline(cin, input);
-                recipe.setDifficulty(stringToDifficulty(input));
-                break;
-            }
+        case 5: {
+            cout << "Enter new grade (A, B, C): ";
+            string input;
+            getline(cin, input);
+            recipe.setDifficulty(stringToDifficulty(input));
+            break;
+        }
 
-            default:
-                cout << "Invalid choice. No changes made." << endl;
-                return;
-            }
-            cout << "Recipe updated successfully." << endl;
+        default:
+            cout << "Invalid choice. No changes made." << endl;
+            searchIndex.afterEdit(row, recipe);
             return;
         }
+        searchIndex.afterEdit(row, recipe);
+        difficultyBuckets.change(searchIndex.idAt(row), before, recipe.getDifficulty());
+        columns.replaceRow(row, recipe);
+        if (journaling) {
+            // 저널에는 수정된 레시피 전체를 기록합니다. (다시 적용할 때 같은 제목 검색으로 같은 레시피를 찾음)
+            string payload = title + "\n";
+            appendRecipeText(payload, recipe);
+            appendJournal("edit", payload);
+        }
+        recipesChanged();
+        maybeCompactArena();
+        cout << "Recipe updated successfully." << endl;
+        return;
     }
     cout << "Recipe not found." << endl;
 }
@@ -443,41 +1775,126 @@ public:
     // Meal이 DB에서 레시피를 찾으려면 내부 vector에 접근해야 해서
     const vector<Recipe> &getRecipes() const { return recipes; }
 
-    // 난이도별 레시피 검색 함수 (추천 시스템용)
-    vector<string> getRecipesByDifficultyLevel(char maxLevel) const
-    {
-        vector<string> result;
+    /*
+     * const RecipeColumns& getColumns() const: 레시피 목록의 열 저장소를 반환합니다. (행 번호 i == getRecipes()[i])
+     * details: 변경마다 바뀐 행만 고쳐 두므로 항상 최신이며, 부르는 비용은 없습니다. 반환된 Row 뷰와 getTitle()의 string_view는 다음 변경 전까지 유효합니다.
+     */
+    const RecipeColumns &getColumns() const { return columns; }
 
-        for (const auto &recipe : recipes)
+    /*
+     * const PantryIndex& getPantryIndex() const: 레시피별 재료 비트 집합 색인을 반환합니다. (행 번호 i == getRecipes()[i])
+     * details: 마지막으로 만든 뒤 레시피가 바뀌었으면 이때 다시 만듭니다.
+     */
+    const PantryIndex &getPantryIndex() const
+    {
+        if (pantryStale)
         {
-            Difficulty recipeDiff = recipe.getDifficulty();
+            pantryIndex.rebuild(recipes);
+            pantryStale = false;
+        }
+        return pantryIndex;
+    }
 
-            // 선택된 난이도 이하의 레시피만 포함
-            bool shouldInclude = false;
+    // 키워드 검색 / 제목 색인 (로딩 직후 만들고 이후 변경마다 갱신됨)
+    const RecipeSearchIndex &getSearchIndex() const { return searchIndex; }
 
-            if (maxLevel == 'A')
-            {
-                // A 선택: A, B, C 모든 난이도 포함
-                shouldInclude = true;
-            }
-            else if (maxLevel == 'B')
-            {
-                // B 선택: B, C 난이도만 포함 (A 제외)
-                shouldInclude = (recipeDiff == Difficulty::B || recipeDiff == Difficulty::C);
-            }
-            else if (maxLevel == 'C')
-            {
-                // C 선택: C 난이도만 포함
-                shouldInclude = (recipeDiff == Difficulty::C);
-            }
+    /*
+     * const Recipe* findRecipeByTitle(string_view title) const: 제목이 정확히 title인 첫 레시피를 제목 해시 색인으로 찾습니다.
+     * return 없으면 nullptr. 포인터는 다음 변경(삽입/삭제/정렬 등) 전까지만 유효합니다.
+     */
+    const Recipe *findRecipeByTitle(string_view title) const
+    {
+        vector<uint32_t> rows = searchIndex.rowsWithTitle(title, recipes);
+        return rows.empty() ? nullptr : &recipes[rows[0]];
+    }
 
-            if (shouldInclude)
-            {
-                result.push_back(recipe.getTitle());
-            }
-        }
+    /*
+     * RecipeHandle findHandleByTitle(string_view title) const: 제목이 정확히 title인 첫 레시피의 핸들 (없으면 valid()가 false)
+     * RecipeHandle handleOf(size_t row) const: getRecipes()[row]의 핸들
+     * details: 핸들은 슬롯 번호 + 세대 8바이트뿐이므로, 식단처럼 레시피를 오래 가리켜야 하는 곳은 Recipe를 복사하지 않고 핸들을 저장합니다.
+     */
+    RecipeHandle findHandleByTitle(string_view title) const
+    {
+        vector<uint32_t> rows = searchIndex.rowsWithTitle(title, recipes);
+        return rows.empty() ? RecipeHandle() : handleOf(rows[0]);
+    }
+    RecipeHandle handleOf(size_t row) const
+    {
+        return searchIndex.handleAt(row);
+    }
 
-        return result;
+    /*
+     * const Recipe* resolve(RecipeHandle handle) const: 핸들이 가리키는 레시피를 현재 행에서 찾습니다. O(1)
+     * details: 슬롯의 세대를 비교하므로, 지워진 레시피의 핸들은 그 슬롯을 다시 쓴 새 레시피로 잘못 이어지지 않습니다.
+     * return 레시피가 삭제되었으면 nullptr. 포인터는 다음 변경(삽입/삭제/정렬 등) 전까지만 유효합니다.
+     */
+    const Recipe *resolve(RecipeHandle handle) const
+    {
+        uint32_t row;
+        if (!handle.valid() || !searchIndex.findRow(handle, row))
+            return nullptr;
+        return &recipes[row];
+    }
+
+    /*
+     * vector<string> suggestTitles(string_view title, size_t maxResults = 3) const: title을 잘못 입력했을 때 제안할 비슷한 제목들
+     * details: 대소문자를 무시한 편집 거리로 찾으며, 허용 거리는 입력이 5자 이하면 1, 더 길면 2입니다.
+     *          거리 1부터 넓혀 가며 처음으로 제목이 나오는 거리에서 멈추므로, 흔한 한 글자 오타는 가장 좁은 검색으로 끝납니다.
+     *          제목 BK-tree(RecipeSearchIndex::rowsWithSimilarTitle)로 찾으므로 전체 제목과 하나씩 비교하지 않습니다.
+     * return 가까운 순서의 제목 (없으면 빈 목록)
+     */
+    vector<string> suggestTitles(string_view title, size_t maxResults = 3) const
+    {
+        uint32_t maxDistance = title.size() <= 5 ? 1 : 2;
+        vector<uint32_t> rows;
+        for (uint32_t distance = 1; distance <= maxDistance && rows.empty(); distance++)
+            rows = searchIndex.rowsWithSimilarTitle(title, distance, maxResults, recipes);
+        vector<string> titles;
+        for (uint32_t row : rows)
+            titles.emplace_back(recipes[row].getTitle());
+        return titles;
+    }
+
+    // --- 문자열 아레나 ---
+
+    /*
+     * void compactArena(): 살아있는 레시피의 제목/조리 절차만 새 아레나로 옮겨, 삭제/수정으로 생긴 쓰레기 공간을 회수합니다.
+     * details: 이전 아레나는 그것을 참조하는 Recipe 값 복사본이 모두 사라질 때 해제되므로, 복사본의 문자열도 안전합니다.
+     *          Meal은 레시피 핸들만 가지므로 아레나를 붙잡지 않습니다. (레시피는 쓸 때마다 핸들로 데이터베이스에서 찾음)
+     */
+    void compactArena() {
+        arenaPeakBytes = max(arenaPeakBytes, arena->getPeakReservedBytes());
+        auto compacted = make_shared<TextArena>(arena->getLiveBytes());
+        for (auto &recipe : recipes)
+            recipe.moveTextTo(compacted);
+        arena = std::move(compacted);
+        recipesChanged();
+    }
+
+    // 아레나 사용량을 출력합니다. live: 살아있는 문자열, used: 쓰레기 포함 저장량, reserved: 블록 용량, peak: 지금까지 최대 블록 용량
+    void printArenaStats() const {
+        cout << "Text arena: live " << arena->getLiveBytes() << " bytes, used " << arena->getUsedBytes()
+             << " bytes (garbage " << arena->getGarbageBytes() << "), reserved " << arena->getReservedBytes()
+             << " bytes in " << arena->getBlockCount() << " block(s), peak "
+             << max(arenaPeakBytes, arena->getPeakReservedBytes()) << " bytes" << endl;
+    }
+    const TextArena& getArena() const { return *arena; }
+
+    // --- 난이도별 조회 (추천 시스템용) ---
+
+    // 난이도가 d인 레시피의 행 번호 뷰 (목록 순서 아님). id 목록을 복사하지 않으며 다음 변경 전까지 유효합니다.
+    DifficultyRows getRowsByDifficulty(Difficulty d) const { return difficultyBuckets.rowsOf(d, searchIndex.getSlots()); }
+
+    /*
+     * DifficultyRows getRowsUpToDifficulty(char maxLevel) const: 선택된 난이도 이하의 레시피 행 번호 뷰를 돌려줍니다.
+     * details: A 선택: A, B, C 모든 난이도 포함 / B 선택: B, C 난이도만 포함 (A 제외) / C 선택: C 난이도만 포함
+     * return 쉬운 난이도(C)부터 이어지는 뷰. 잘못된 문자면 빈 뷰입니다.
+     */
+    DifficultyRows getRowsUpToDifficulty(char maxLevel) const
+    {
+        if (maxLevel != 'A' && maxLevel != 'B' && maxLevel != 'C')
+            return DifficultyRows();
+        return difficultyBuckets.rowsUpTo(static_cast<Difficulty>(maxLevel - 'A'), searchIndex.getSlots());
     }
 };
 
@@ -0,0 +1,103 @@
+#ifndef RECIPE_QUERY_H
+#define RECIPE_QUERY_H
+
+#include <climits> // INT_MIN, INT_MAX: 시간 범위의 기본값
+#include <string>
+#include <vector>
+#include "Recipe.h"
+#include "RowBitmap.h" // 조건별 결과를 합치는 압축 비트맵
+
+using namespace std;
+
+/**
+ * RecipeQuery 클래스
+ * --------------------------
+ * 여러 조건을 한 번에 거는 레시피 질의. 모든 조건을 만족하는(AND) 레시피를 찾습니다.
+ * 예: "난이도 B 또는 C, 30분 이하, chicken 포함, cream 제외"
+ *     RecipeQuery().difficulty(Difficulty::B).difficulty(Difficulty::C).timeAtMost(30).withIngredient("chicken").withoutIngredient("cream")
+ *
+ * - difficulty: 한 번도 부르지 않으면 모든 난이도, 여러 번 부르면 그중 하나(OR)
+ * - 시간: 조리 시간(분)이 [minTime, maxTime] 안에 있어야 함
+ * - 재료: 이름에 단어가 (대소문자 구분 없이) 들어 있는 재료를 기준으로, withIngredient는 모두 포함(AND), withoutIngredient는 하나도 포함하지 않음
+ * 실제 계산은 RecipeDatabase::queryRecipes가 조건마다 행 번호 비트맵을 만들어 교집합/차집합으로 합칩니다.
+ */
+class RecipeQuery
+{
+private:
+    bool difficulties[3] = {false, false, false}; // A, B, C 순서
+    bool anyDifficulty = true;
+    int minTime = INT_MIN;
+    int maxTime = INT_MAX;
+    vector<string> requiredIngredients;
+    vector<string> excludedIngredients;
+
+public:
+    RecipeQuery &difficulty(Difficulty d)
+    {
+        anyDifficulty = false;
+        difficulties[static_cast<int>(d)] = true;
+        return *this;
+    }
+    RecipeQuery &timeBetween(int minMinutes, int maxMinutes)
+    {
+        minTime = minMinutes;
+        maxTime = maxMinutes;
+        return *this;
+    }
+    RecipeQuery &timeAtMost(int maxMinutes) { return timeBetween(INT_MIN, maxMinutes); }
+    RecipeQuery &withIngredient(const string &name)
+    {
+        requiredIngredients.push_back(name);
+        return *this;
+    }
+    RecipeQuery &withoutIngredient(const string &name)
+    {
+        excludedIngredients.push_back(name);
+        return *this;
+    }
+
+    bool restrictsDifficulty() const { return !anyDifficulty; }
+    bool allowsDifficulty(Difficulty d) const { return anyDifficulty || difficulties[static_cast<int>(d)]; }
+    bool restrictsTime() const { return minTime != INT_MIN || maxTime != INT_MAX; }
+    bool allowsTime(int minutes) const { return minutes >= minTime && minutes <= maxTime; }
+    const vector<string> &getRequiredIngredients() const { return requiredIngredients; }
+    const vector<string> &getExcludedIngredients() const { return excludedIngredients; }
+};
+
+/**
+ * RecipeQueryResult 클래스
+ * --------------------------
+ * 질의 결과: 조건을 만족하는 행 번호 비트맵. 제목이나 Recipe를 미리 꺼내 두지 않고, 반복할 때 하나씩 꺼냅니다.
+ * - count(): 비트맵에 저장된 개수만 더하므로, 개수만 필요한 질의는 레시피를 전혀 건드리지 않습니다.
+ * - for (uint32_t row : result): 행 번호를 오름차순(목록 순서)으로 꺼냄
+ * 레시피 목록이 바뀌면(삽입/수정/삭제/정렬) 더 이상 유효하지 않습니다.
+ */
+class RecipeQueryResult
+{
+private:
+    RowBitmap rows;
+    const vector<Recipe> *recipes;
+
+public:
+    RecipeQueryResult(RowBitmap rows, const vector<Recipe> *recipes) : rows(std::move(rows)), recipes(recipes) {}
+
+    size_t count() const { return rows.count(); }
+    bool empty() const { return rows.empty(); }
+    bool contains(uint32_t row) const { return rows.contains(row); }
+
+    RowBitmap::const_iterator begin() const { return rows.begin(); }
+    RowBitmap::const_iterator end() const { return rows.end(); }
+
+    /*
+     * void forEachRecipe(Visitor visit) const: 결과 레시피마다 visit(row, const Recipe&)를 목록 순서대로 호출합니다.
+     */
+    template <typename Visitor>
+    void forEachRecipe(Visitor visit) const
+    {
+        rows.forEach([&](uint32_t row) { visit(row, (*recipes)[row]); });
+    }
+
+    const RowBitmap &getRows() const { return rows; }
+};
+
+#endif // RECIPE_QUERY_H
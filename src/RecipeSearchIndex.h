@@ -0,0 +1,485 @@
+#ifndef RECIPE_SEARCH_INDEX_H
+#define RECIPE_SEARCH_INDEX_H
+
+#include <algorithm>   // std::lower_bound, std::sort, std::nth_element
+#include <cstdint>     // uint32_t
+#include <memory>      // std::unique_ptr: 어휘 표 소유
+#include <string>
+#include <string_view> // 검색어/제목을 복사 없이 다루기 위해 포함
+#include <utility>     // std::pair
+#include <vector>
+#include "Recipe.h"
+#include "SymbolTable.h" // 제목 토큰 어휘 (소문자 토큰 -> 토큰 id)
+#include "TrigramIndex.h" // 토큰/재료 이름에서 부분 문자열을 포함하는 것을 찾는 색인
+#include "RecipeColumns.h" // 이어 붙인 제목 문자열 (토큰으로 좁힐 수 없는 검색어용)
+#include "TitleHashTable.h" // 제목 -> 레시피 id 해시 표
+#include "TitleBKTree.h" // 편집 거리로 비슷한 제목을 찾는 BK-tree
+#include "RecipeSlotMap.h" // 레시피 id(슬롯) -> 행 번호, 세대 카운터로 지워진 레시피의 핸들을 가려냄
+#include "BitOps.h" // lowestBit
+
+using namespace std;
+
+// 순위 검색 결과 하나: 행 번호와 점수 (점수가 높을수록 앞)
+struct SearchHit
+{
+    uint32_t row;
+    int score;
+};
+
+// 순위 검색의 한 페이지: 요청한 범위의 결과와 전체 일치 개수
+struct SearchPage
+{
+    vector<SearchHit> hits;
+    size_t totalMatches = 0;
+};
+
+/**
+ * RecipeSearchIndex 클래스
+ * --------------------------
+ * 키워드 검색용 역색인(inverted index). "토큰 -> 그 토큰을 가진 레시피 id 목록(posting list)"을 미리 만들어 둡니다.
+ * - 제목: 소문자로 바꾼 제목을 단어 문자(영숫자, 비ASCII 바이트)의 연속 구간(토큰)으로 나누어 토큰별로 레시피 id를 기록
+ * - 재료: 재료 이름 심볼 id별로 그 재료를 쓰는 레시피 id를 기록
+ *
+ * 검색 결과는 기존 전체 스캔(소문자 제목/재료 이름에 키워드가 부분 문자열로 들어 있는지)과 같습니다.
+ * 키워드의 각 단어 구간은 제목의 어떤 토큰 안에 반드시 들어 있으므로, 가장 드문 구간을 가진 레시피만 실제 제목(미리 만들어 둔 소문자 키)으로 확인합니다.
+ * 구간을 포함하는 토큰/재료 이름은 트라이그램 색인(TrigramIndex)으로 찾으므로, "chick", "masal" 같은 단어 조각도 어휘 전체를 훑지 않습니다.
+ * 따라서 검색 비용은 레시피 수가 아니라 후보 수(와 결과 비트맵 크기 / 64)에 비례합니다.
+ *
+ * 또한 정확한 제목과 소문자 제목(getTitleKey)으로 레시피를 바로 찾는 해시 표를 함께 관리합니다. (Meal 추가, 삭제, 수정의 제목 조회)
+ * 제목을 잘못 입력했을 때의 "혹시 이 레시피?" 제안용 BK-tree는 처음 필요할 때 만들고, 그 뒤로는 함께 갱신합니다.
+ *
+ * 레시피 id는 행 번호와 달리 삭제/정렬에도 바뀌지 않으며, idOfRow/slots로 현재 행 번호와 서로 바꿉니다.
+ * id는 슬롯 맵(RecipeSlotMap)의 슬롯 번호라 지운 레시피의 id는 새 레시피에 다시 쓰이고, 밖으로 내보내는 핸들은 세대로 구분합니다.
+ * RecipeDatabase가 삽입/수정/삭제/정렬 때마다 아래 함수로 색인을 함께 갱신합니다.
+ */
+class RecipeSearchIndex
+{
+private:
+    static constexpr uint32_t kNoRow = 0xFFFFFFFFu; // 삭제 표시된 행 (idOfRow)
+
+    unique_ptr<SymbolTable> vocabulary = make_unique<SymbolTable>(); // 제목 토큰 (소문자) -> 토큰 id
+    TrigramIndex tokenKeys;                          // 토큰 id -> 토큰 (부분 문자열 검색용 트라이그램 색인)
+    TrigramIndex nameKeys;                           // 재료 이름 심볼 id -> 소문자 이름 (색인에 추가할 때 새 심볼만 채움)
+    vector<vector<uint32_t>> titlePostings;          // 토큰 id -> 레시피 id (오름차순)
+    vector<vector<uint32_t>> ingredientPostings;     // 재료 이름 심볼 id -> 레시피 id (오름차순)
+    TitleHashTable exactTitles;                      // 제목 -> 레시피 id
+    TitleHashTable foldedTitles;                     // 소문자 제목 -> 레시피 id
+    mutable TitleBKTree similarTitles;               // 소문자 제목 BK-tree (처음 제안할 때 만듦)
+    mutable bool similarTitlesBuilt = false;
+    vector<uint32_t> idOfRow;                        // 행 번호 -> 레시피 id
+    RecipeSlotMap slots;                             // 레시피 id -> 행 번호 + 세대
+
+    // 검색과 같은 규칙(tolower)으로 대소문자를 구분하지 않는 단어 문자인지 확인합니다.
+    static bool isWordByte(unsigned char c)
+    {
+        return c >= 0x80 || (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    }
+
+    // text의 토큰마다 (소문자로 바꾼) 토큰을 token에 담아 visit(token)을 호출합니다.
+    template <typename Visitor>
+    static void forEachToken(string_view text, string &token, Visitor visit)
+    {
+        size_t i = 0;
+        while (i < text.size())
+        {
+            while (i < text.size() && !isWordByte(static_cast<unsigned char>(text[i])))
+                i++;
+            token.clear();
+            while (i < text.size() && isWordByte(static_cast<unsigned char>(text[i])))
+                token += Recipe::foldChar(text[i++]);
+            if (!token.empty())
+                visit(string_view(token));
+        }
+    }
+
+    static void addPosting(vector<uint32_t> &list, uint32_t id)
+    {
+        if (list.empty() || list.back() < id)
+        {
+            list.push_back(id);
+            return;
+        }
+        auto it = lower_bound(list.begin(), list.end(), id);
+        if (*it != id)
+            list.insert(it, id);
+    }
+
+    static void removePosting(vector<uint32_t> &list, uint32_t id)
+    {
+        auto it = lower_bound(list.begin(), list.end(), id);
+        if (it != list.end() && *it == id)
+            list.erase(it);
+    }
+
+    // 레시피 id의 제목 토큰/재료를 색인에 추가합니다.
+    void link(uint32_t id, const Recipe &recipe)
+    {
+        exactTitles.insert(recipe.getTitle(), id);
+        foldedTitles.insert(recipe.getTitleKey(), id);
+        if (similarTitlesBuilt)
+            similarTitles.insert(recipe.getTitleKey());
+        string token;
+        forEachToken(recipe.getTitleKey(), token, [&](string_view t) {
+            uint32_t tokenId = vocabulary->intern(t);
+            if (tokenId >= titlePostings.size())
+            {
+                titlePostings.resize(tokenId + 1);
+                tokenKeys.append(t);
+            }
+            addPosting(titlePostings[tokenId], id);
+        });
+        if (recipe.getSymbols())
+            syncLowerNames(*recipe.getSymbols());
+        for (const auto &ing : recipe.getIngredient())
+        {
+            if (ing.nameId >= ingredientPostings.size())
+                ingredientPostings.resize(ing.nameId + 1);
+            addPosting(ingredientPostings[ing.nameId], id);
+        }
+    }
+
+    // 레시피 id의 제목 토큰/재료를 색인에서 뺍니다. recipe는 link할 때와 같은 내용이어야 합니다.
+    void unlink(uint32_t id, const Recipe &recipe)
+    {
+        exactTitles.erase(recipe.getTitle(), id);
+        foldedTitles.erase(recipe.getTitleKey(), id);
+        if (similarTitlesBuilt)
+            similarTitles.erase(recipe.getTitleKey());
+        string token;
+        forEachToken(recipe.getTitleKey(), token, [&](string_view t) {
+            uint32_t tokenId;
+            if (vocabulary->find(t, tokenId))
+                removePosting(titlePostings[tokenId], id);
+        });
+        for (const auto &ing : recipe.getIngredient())
+        {
+            if (ing.nameId < ingredientPostings.size())
+                removePosting(ingredientPostings[ing.nameId], id);
+        }
+    }
+
+    /*
+     * static int matchScore(string_view key, string_view lowerKeyword, int base): key 안에서 키워드가 어떻게 일치하는지에 따른 점수
+     * return 일치하지 않으면 0, 아니면 base에 전체 일치 +30, 앞부분 일치 +20, 단어 시작 일치 +10을 더한 값
+     */
+    static int matchScore(string_view key, string_view lowerKeyword, int base)
+    {
+        size_t pos = key.find(lowerKeyword);
+        if (pos == string_view::npos)
+            return 0;
+        if (pos == 0)
+            return base + (key.size() == lowerKeyword.size() ? 30 : 20);
+        if (!isWordByte(static_cast<unsigned char>(key[pos - 1])))
+            return base + 10;
+        return base;
+    }
+
+    void renumberRows(size_t firstRow = 0)
+    {
+        for (size_t row = firstRow; row < idOfRow.size(); row++)
+            slots.setRow(idOfRow[row], static_cast<uint32_t>(row));
+    }
+
+    // 심볼 표에 새로 생긴 재료 이름의 소문자 버전을 채웁니다.
+    void syncLowerNames(const SymbolTable &names)
+    {
+        for (uint32_t id = static_cast<uint32_t>(nameKeys.size()); id < names.size(); id++)
+            nameKeys.append(Recipe::foldKey(names.name(id)));
+    }
+
+public:
+    void clear()
+    {
+        vocabulary = make_unique<SymbolTable>();
+        titlePostings.clear();
+        ingredientPostings.clear();
+        tokenKeys.clear();
+        nameKeys.clear();
+        idOfRow.clear();
+        slots.clear();
+        exactTitles.clear();
+        foldedTitles.clear();
+        similarTitles.clear();
+        similarTitlesBuilt = false;
+    }
+
+    /*
+     * void rebuild(const vector<Recipe> &recipes): 레시피 목록 전체로 색인을 새로 만듭니다. (레시피 id == 행 번호)
+     */
+    void rebuild(const vector<Recipe> &recipes)
+    {
+        clear();
+        idOfRow.reserve(recipes.size());
+        slots.reserve(recipes.size());
+        vocabulary->reserve(recipes.size()); // 서로 다른 토큰 수는 보통 레시피 수보다 적음
+        exactTitles.reserve(recipes.size());
+        foldedTitles.reserve(recipes.size());
+        for (const auto &recipe : recipes)
+            insert(recipe);
+    }
+
+    // 목록 끝에 추가된 레시피를 새 id(빈 슬롯)로 색인합니다.
+    void insert(const Recipe &recipe)
+    {
+        uint32_t id = slots.acquire(static_cast<uint32_t>(idOfRow.size()));
+        idOfRow.push_back(id);
+        link(id, recipe);
+    }
+
+    // 행의 레시피 핸들
+    RecipeHandle handleAt(size_t row) const { return slots.handleOf(idOfRow[row]); }
+
+    // 행의 레시피 id (삭제/정렬에도 바뀌지 않음)
+    uint32_t idAt(size_t row) const { return idOfRow[row]; }
+
+    // 레시피 id -> 현재 행 번호 대응표
+    const RecipeSlotMap &getSlots() const { return slots; }
+
+    /*
+     * bool findRow(RecipeHandle handle, uint32_t &row) const: 핸들의 레시피가 아직 있으면 현재 행 번호를 담고 true를 반환합니다. O(1)
+     */
+    bool findRow(RecipeHandle handle, uint32_t &row) const { return slots.find(handle, row); }
+
+    /*
+     * 수정: 바꾸기 전에 beforeEdit(row, 원래 레시피), 바꾼 뒤에 afterEdit(row, 새 레시피)를 호출합니다. (id는 그대로)
+     */
+    void beforeEdit(size_t row, const Recipe &recipe) { unlink(idOfRow[row], recipe); }
+    void afterEdit(size_t row, const Recipe &recipe) { link(idOfRow[row], recipe); }
+
+    /*
+     * 삭제: 지울 행마다 markErased(row, 레시피)를 호출한 뒤(행 번호는 삭제 전 기준), 실제로 지우고 나서 eraseMarkedRows()를 호출합니다.
+     */
+    void markErased(size_t row, const Recipe &recipe)
+    {
+        uint32_t id = idOfRow[row];
+        unlink(id, recipe);
+        slots.release(id);
+        idOfRow[row] = kNoRow;
+    }
+
+    void eraseMarkedRows()
+    {
+        size_t first = static_cast<size_t>(find(idOfRow.begin(), idOfRow.end(), kNoRow) - idOfRow.begin());
+        idOfRow.erase(remove(idOfRow.begin() + first, idOfRow.end(), kNoRow), idOfRow.end());
+        renumberRows(first); // 첫 삭제 위치 앞쪽의 행 번호는 그대로
+    }
+
+    /*
+     * void permute(const vector<uint32_t> &order): 정렬 등으로 행 순서가 바뀌었을 때 호출합니다. 새 행 i는 이전 행 order[i]입니다.
+     * details: 레시피 id와 posting list는 그대로이고, 행 번호 대응표만 바꿉니다.
+     */
+    void permute(const vector<uint32_t> &order)
+    {
+        vector<uint32_t> reordered(order.size());
+        for (size_t row = 0; row < order.size(); row++)
+            reordered[row] = idOfRow[order[row]];
+        idOfRow = std::move(reordered);
+        renumberRows();
+    }
+
+    /*
+     * vector<uint32_t> search(string_view keyword, const vector<Recipe> &recipes, const RecipeColumns &columns) const:
+     * 제목 또는 재료 이름에 keyword가 (대소문자 구분 없이) 들어 있는 레시피의 행 번호를 오름차순으로 반환합니다.
+     * param recipes 색인과 같은 상태의 레시피 목록 (후보 제목 확인용)
+     * param columns 같은 상태의 열 저장소 (전체 제목 스캔용)
+     * details: 키워드에 단어 문자가 하나도 없으면(빈 문자열, 공백/기호만) 토큰으로 좁힐 수 없으므로,
+     *          이어 붙인 제목 문자열 전체를 벡터 스캔(TextScan)으로 훑습니다.
+     */
+    vector<uint32_t> search(string_view keyword, const vector<Recipe> &recipes, const RecipeColumns &columns) const
+    {
+        string lowerKeyword = Recipe::foldKey(keyword);
+        // 결과는 행 번호 비트맵으로 모읍니다. (정렬/중복 제거 없이 비트 순서대로 꺼내면 오름차순)
+        vector<uint64_t> matchedRows((recipes.size() + 63) / 64);
+        auto markRow = [&](uint32_t row) { matchedRows[row >> 6] |= uint64_t(1) << (row & 63); };
+        auto rowMarked = [&](uint32_t row) { return (matchedRows[row >> 6] >> (row & 63)) & 1; };
+
+        // 1. 재료: 이름에 키워드가 들어 있는 재료(트라이그램 색인)를 찾고, 그 재료를 쓰는 레시피를 표시합니다.
+        nameKeys.forEachContaining(lowerKeyword, [&](uint32_t nameId) {
+            if (nameId < ingredientPostings.size())
+            {
+                for (uint32_t id : ingredientPostings[nameId])
+                    markRow(slots.rowOf(id));
+            }
+        });
+
+        // 2. 제목: 키워드의 단어 구간마다 그것을 포함하는 토큰을 찾고, 레시피 수가 가장 적은 구간의 레시피만 후보로 삼습니다.
+        //    (후보는 어차피 키워드 전체로 다시 확인하므로, 다른 구간과 교집합하지 않아도 결과는 같습니다.)
+        string run;
+        bool narrowed = false;
+        vector<uint32_t> bestTokens, tokens;
+        size_t bestPostings = 0;
+        forEachToken(lowerKeyword, run, [&](string_view part) {
+            tokens.clear();
+            size_t total = 0;
+            tokenKeys.forEachContaining(part, [&](uint32_t tokenId) {
+                tokens.push_back(tokenId);
+                total += titlePostings[tokenId].size();
+            });
+            if (!narrowed || total < bestPostings)
+            {
+                bestTokens.swap(tokens);
+                bestPostings = total;
+            }
+            narrowed = true;
+        });
+
+        if (!narrowed)
+        {
+            // 단어 문자가 없는 키워드: 모든 제목을 스캔 (재료 쪽은 1단계에서 이미 표시됨)
+            columns.forEachTitleContaining(lowerKeyword, markRow);
+        }
+        else
+        {
+            // 후보의 제목 키에 키워드 전체가 들어 있는지 확인합니다. (이미 표시된 행은 건너뜀)
+            for (uint32_t tokenId : bestTokens)
+            {
+                for (uint32_t id : titlePostings[tokenId])
+                {
+                    uint32_t row = slots.rowOf(id);
+                    if (!rowMarked(row) && recipes[row].getTitleKey().find(lowerKeyword) != string_view::npos)
+                        markRow(row);
+                }
+            }
+        }
+
+        // 3. 표시된 행 번호를 오름차순으로 꺼냅니다. (기존 검색과 같은 목록 순서)
+        vector<uint32_t> rows;
+        for (size_t w = 0; w < matchedRows.size(); w++)
+        {
+            for (uint64_t bits = matchedRows[w]; bits; bits &= bits - 1)
+                rows.push_back(static_cast<uint32_t>(w * 64 + BitOps::lowestBit(bits)));
+        }
+        return rows;
+    }
+
+    static constexpr int kTitleScore = 200;      // 제목 일치 (어떤 재료 일치보다도 높음)
+    static constexpr int kIngredientScore = 100; // 재료 이름 일치
+
+    /*
+     * SearchPage searchRanked(string_view keyword, const vector<Recipe> &recipes, const RecipeColumns &columns, size_t offset, size_t limit) const:
+     * search()와 같은 레시피를 점수 순으로 정렬했을 때 offset번째부터 limit개를 반환합니다.
+     * details: 점수는 제목 일치(200)가 재료 이름 일치(100)보다 높고, 각각 전체 일치 +30 / 앞부분 일치 +20 / 단어 시작 일치 +10입니다.
+     *          점수가 같으면 목록 순서(행 번호)대로입니다.
+     *          일치한 레시피마다 점수만 매긴 뒤, 앞쪽 offset + limit개만 nth_element로 골라 그 부분만 정렬합니다. (전체 정렬 안 함)
+     */
+    SearchPage searchRanked(string_view keyword, const vector<Recipe> &recipes, const RecipeColumns &columns, size_t offset, size_t limit) const
+    {
+        string lowerKeyword = Recipe::foldKey(keyword);
+        vector<uint32_t> rows = search(keyword, recipes, columns);
+        SearchPage page;
+        page.totalMatches = rows.size();
+        if (offset >= rows.size() || limit == 0)
+            return page;
+
+        vector<SearchHit> hits;
+        hits.reserve(rows.size());
+        for (uint32_t row : rows)
+        {
+            int score = matchScore(recipes[row].getTitleKey(), lowerKeyword, kTitleScore);
+            if (score == 0)
+            {
+                for (const auto &ing : recipes[row].getIngredient())
+                {
+                    if (ing.nameId < nameKeys.size())
+                        score = max(score, matchScore(nameKeys.key(ing.nameId), lowerKeyword, kIngredientScore));
+                }
+            }
+            hits.push_back(SearchHit{row, score});
+        }
+
+        auto better = [](const SearchHit &a, const SearchHit &b) {
+            return a.score != b.score ? a.score > b.score : a.row < b.row;
+        };
+        size_t end = min(hits.size(), offset + min(limit, hits.size()));
+        if (end < hits.size())
+            nth_element(hits.begin(), hits.begin() + end, hits.end(), better);
+        sort(hits.begin(), hits.begin() + end, better);
+        page.hits.assign(hits.begin() + offset, hits.begin() + end);
+        return page;
+    }
+
+    /*
+     * vector<uint32_t> rowsWithIngredient(string_view term) const: 이름에 term이 (대소문자 구분 없이) 들어 있는 재료를 쓰는 레시피의 행 번호
+     * details: 순서가 정해져 있지 않고, 그런 재료를 여러 개 쓰는 레시피는 여러 번 나올 수 있습니다.
+     */
+    vector<uint32_t> rowsWithIngredient(string_view term) const
+    {
+        vector<uint32_t> rows;
+        nameKeys.forEachContaining(Recipe::foldKey(term), [&](uint32_t nameId) {
+            if (nameId < ingredientPostings.size())
+            {
+                for (uint32_t id : ingredientPostings[nameId])
+                    rows.push_back(slots.rowOf(id));
+            }
+        });
+        return rows;
+    }
+
+    /*
+     * vector<uint32_t> rowsWithTitle(string_view title, const vector<Recipe> &recipes) const: 제목이 정확히 title인 레시피의 행 번호 (오름차순)
+     * vector<uint32_t> rowsWithTitleKey(string_view key, const vector<Recipe> &recipes) const: 소문자 제목이 key인 레시피의 행 번호 (오름차순)
+     * details: 해시 표로 후보 id만 꺼내 실제 제목과 비교하므로, 레시피 수와 관계없이 같은 제목의 개수만큼만 일합니다.
+     */
+    vector<uint32_t> rowsWithTitle(string_view title, const vector<Recipe> &recipes) const
+    {
+        vector<uint32_t> rows;
+        exactTitles.forEachCandidate(title, [&](uint32_t id) {
+            if (recipes[slots.rowOf(id)].getTitle() == title)
+                rows.push_back(slots.rowOf(id));
+        });
+        sort(rows.begin(), rows.end());
+        return rows;
+    }
+    vector<uint32_t> rowsWithTitleKey(string_view key, const vector<Recipe> &recipes) const
+    {
+        vector<uint32_t> rows;
+        foldedTitles.forEachCandidate(key, [&](uint32_t id) {
+            if (recipes[slots.rowOf(id)].getTitleKey() == key)
+                rows.push_back(slots.rowOf(id));
+        });
+        sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+    /*
+     * vector<uint32_t> rowsWithSimilarTitle(string_view title, uint32_t maxDistance, size_t maxResults, const vector<Recipe> &recipes) const:
+     * 소문자 제목이 title(대소문자 무시)과 편집 거리 maxDistance 이내인 레시피를 가까운 순서로 최대 maxResults개 찾습니다.
+     * details: 같은 소문자 제목의 레시피가 여러 개면 목록에서 가장 앞의 것 하나만 돌려줍니다.
+     *          BK-tree는 처음 호출할 때 현재 레시피 목록으로 만듭니다.
+     * return 행 번호 (거리, 제목 순)
+     */
+    vector<uint32_t> rowsWithSimilarTitle(string_view title, uint32_t maxDistance, size_t maxResults, const vector<Recipe> &recipes) const
+    {
+        if (!similarTitlesBuilt)
+        {
+            size_t keyBytes = 0;
+            for (const auto &recipe : recipes)
+                keyBytes += recipe.getTitleKey().size();
+            similarTitles.reserve(recipes.size(), keyBytes);
+            for (const auto &recipe : recipes)
+                similarTitles.insert(recipe.getTitleKey());
+            similarTitlesBuilt = true;
+        }
+
+        vector<pair<uint32_t, string_view>> matches; // (거리, 소문자 제목)
+        similarTitles.forEachWithin(Recipe::foldKey(title), maxDistance, [&](string_view key, uint32_t distance) {
+            matches.emplace_back(distance, key);
+        });
+        sort(matches.begin(), matches.end());
+
+        vector<uint32_t> rows;
+        for (const auto &match : matches)
+        {
+            if (rows.size() >= maxResults)
+                break;
+            vector<uint32_t> same = rowsWithTitleKey(match.second, recipes);
+            if (!same.empty())
+                rows.push_back(same[0]);
+        }
+        return rows;
+    }
+
+    size_t getTokenCount() const { return vocabulary->size(); }
+};
+
+#endif // RECIPE_SEARCH_INDEX_H
@@ -0,0 +1,114 @@
+#ifndef RECIPE_SLOT_MAP_H
+#define RECIPE_SLOT_MAP_H
+
+#include <cstdint> // uint32_t
+#include <vector>
+
+using namespace std;
+
+// 레시피를 가리키는 작은 핸들 (슬롯 번호 + 세대). 행 번호와 달리 다른 레시피의 삭제/정렬에도 바뀌지 않습니다.
+// RecipeDatabase::resolve로 레시피를 얻으며, 가리키던 레시피가 삭제되었으면 (슬롯이 다른 레시피에 다시 쓰였더라도) nullptr가 나옵니다.
+struct RecipeHandle
+{
+    static constexpr uint32_t kInvalid = 0xFFFFFFFFu;
+    uint32_t index = kInvalid;
+    uint32_t generation = 0;
+
+    bool valid() const { return index != kInvalid; }
+    bool operator==(const RecipeHandle &other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const RecipeHandle &other) const { return !(*this == other); }
+};
+
+/**
+ * RecipeSlotMap 클래스
+ * --------------------------
+ * 레시피 id(슬롯 번호) -> 현재 행 번호 대응표. 슬롯마다 세대(generation) 카운터를 둡니다.
+ * - acquire(row): 빈 슬롯을 하나 꺼내(없으면 끝에 추가) 행 번호를 기록하고 슬롯 번호를 반환합니다. O(1)
+ * - release(id): 슬롯을 비우고 세대를 1 올린 뒤 빈 슬롯 목록에 넣습니다. O(1)
+ * - find(handle): 슬롯의 세대가 핸들과 같을 때만 행 번호를 돌려주므로, 지워진 레시피의 핸들은
+ *   그 슬롯이 새 레시피에 다시 쓰이더라도 새 레시피를 가리키지 않습니다.
+ *
+ * 지운 슬롯을 다시 쓰므로 표의 크기는 지금까지 추가한 레시피 수가 아니라 한 번에 있었던 최대 레시피 수를 따라갑니다.
+ */
+class RecipeSlotMap
+{
+public:
+    static constexpr uint32_t kNoRow = 0xFFFFFFFFu; // 빈 슬롯
+
+private:
+    struct Slot
+    {
+        uint32_t row = kNoRow;
+        uint32_t generation = 0;
+    };
+
+    vector<Slot> slots;
+    vector<uint32_t> freeSlots; // 빈 슬롯 번호 (마지막에 비운 것부터 다시 씀)
+
+public:
+    void clear()
+    {
+        slots.clear();
+        freeSlots.clear();
+    }
+
+    void reserve(size_t expected) { slots.reserve(expected); }
+
+    // 사용 중인 슬롯 수 (= 레시피 수)
+    size_t size() const { return slots.size() - freeSlots.size(); }
+    // 만든 슬롯 수 (빈 슬롯 포함)
+    size_t capacity() const { return slots.size(); }
+
+    uint32_t acquire(uint32_t row)
+    {
+        uint32_t id;
+        if (freeSlots.empty())
+        {
+            id = static_cast<uint32_t>(slots.size());
+            slots.emplace_back();
+        }
+        else
+        {
+            id = freeSlots.back();
+            freeSlots.pop_back();
+        }
+        slots[id].row = row;
+        return id;
+    }
+
+    void release(uint32_t id)
+    {
+        slots[id].row = kNoRow;
+        slots[id].generation++;
+        freeSlots.push_back(id);
+    }
+
+    // 사용 중인 슬롯의 행 번호 (확인 없음)
+    uint32_t rowOf(uint32_t id) const { return slots[id].row; }
+    void setRow(uint32_t id, uint32_t row) { slots[id].row = row; }
+
+    // 사용 중인 슬롯의 현재 핸들
+    RecipeHandle handleOf(uint32_t id) const
+    {
+        RecipeHandle handle;
+        handle.index = id;
+        handle.generation = slots[id].generation;
+        return handle;
+    }
+
+    /*
+     * bool find(RecipeHandle handle, uint32_t &row) const: 핸들이 가리키는 레시피가 아직 있으면 행 번호를 담고 true를 반환합니다.
+     */
+    bool find(RecipeHandle handle, uint32_t &row) const
+    {
+        if (handle.index >= slots.size())
+            return false;
+        const Slot &slot = slots[handle.index];
+        if (slot.generation != handle.generation || slot.row == kNoRow)
+            return false;
+        row = slot.row;
+        return true;
+    }
+};
+
+#endif // RECIPE_SLOT_MAP_H
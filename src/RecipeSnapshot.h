@@ -0,0 +1,309 @@
+#ifndef RECIPE_SNAPSHOT_H
+#define RECIPE_SNAPSHOT_H
+
+#include <cstdint>       // 고정 크기 정수 타입 (uint32_t, uint64_t)
+#include <cstring>       // memcpy, memcmp: 바이너리 헤더/레코드를 읽고 쓰기 위해 포함
+#include <memory>        // std::shared_ptr: 지연 로딩용 ProcedureSource
+#include <fstream>       // std::ifstream: 헤더만 읽을 때 사용
+#include <iterator>      // std::make_move_iterator
+#include <string>
+#include <string_view>
+#include <unordered_map> // 문자열 테이블 중복 제거
+#include <vector>
+#include "Recipe.h"
+#include "MappedFile.h"
+#include "AtomicFile.h"
+#include "SymbolTable.h"
+
+using namespace std;
+
+/**
+ * RecipeSnapshot
+ * --------------------------
+ * RecipeDatabase를 빠르게 시작하기 위한 버전 관리되는 바이너리 스냅샷 형식입니다.
+ * 텍스트 형식(Recipe.txt)은 그대로 교환용 형식이고, 스냅샷은 시작 속도를 위한 캐시입니다.
+ *
+ * 파일 구성 (모든 값은 little-endian 기계의 기본 표현):
+ *  [SnapshotHeader]        고정 크기 헤더 (매직, 버전, 각 테이블의 위치, 원본 텍스트 정보)
+ *  [SnapshotRecipe  x N]   고정 크기 레시피 레코드
+ *  [SnapshotIngredient x M] 고정 크기 재료 레코드 (레시피별로 연속 구간)
+ *  [string table]          모든 문자열을 이어 붙인 영역 (같은 문자열은 한 번만 저장)
+ *
+ * 읽을 때는 파일 전체를 한 번 매핑하고, 숫자 변환(stoi/stod)이나 토큰 분리 없이 레코드를 그대로 읽습니다.
+ */
+namespace RecipeSnapshot
+{
+    const char kMagic[8] = {'I', 'I', 'K', 'H', 'S', 'N', 'A', 'P'};
+    const uint32_t kVersion = 1;
+    const uint32_t kByteOrderMark = 0x01020304; // 다른 바이트 순서의 기계에서 만든 파일을 거부하기 위한 표식
+
+    struct SnapshotHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrderMark;
+        uint64_t recipeCount;
+        uint64_t ingredientCount;
+        uint64_t recipeTableOffset;
+        uint64_t ingredientTableOffset;
+        uint64_t stringTableOffset;
+        uint64_t stringTableSize;
+        uint64_t sourceSize;  // 스냅샷을 만든 원본 텍스트 파일의 크기
+        int64_t sourceMtime;  // 원본 텍스트 파일의 수정 시각 (오래된 스냅샷 판별용)
+    };
+
+    struct SnapshotRecipe
+    {
+        uint64_t titleOffset; // 문자열 테이블 안의 위치
+        uint64_t procedureOffset;
+        uint32_t titleLength;
+        uint32_t procedureLength;
+        uint32_t ingredientFirst; // 재료 테이블 안의 시작 인덱스
+        uint32_t ingredientCount;
+        int32_t time;
+        uint32_t difficulty; // 0: A, 1: B, 2: C
+    };
+
+    struct SnapshotIngredient
+    {
+        uint64_t nameOffset;
+        uint64_t unitOffset;
+        uint32_t nameLength;
+        uint32_t unitLength;
+        double quantity;
+    };
+
+    static_assert(sizeof(SnapshotHeader) == 80, "SnapshotHeader layout changed");
+    static_assert(sizeof(SnapshotRecipe) == 40, "SnapshotRecipe layout changed");
+    static_assert(sizeof(SnapshotIngredient) == 32, "SnapshotIngredient layout changed");
+
+    /*
+     * bool write(const string &path, const vector<Recipe> &recipes, uint64_t sourceSize, int64_t sourceMtime, SyncPolicy policy): 레시피 목록을 스냅샷 파일로 저장합니다.
+     * details: 먼저 메모리에서 세 테이블을 모두 만든 뒤, 헤더와 함께 네 조각을 AtomicFile로 원자적으로 씁니다.
+     * 재료 이름과 단위처럼 반복되는 문자열은 문자열 테이블에 한 번만 저장합니다.
+     * return 저장 성공 시 true
+     */
+    inline bool write(const string &path, const vector<Recipe> &recipes, uint64_t sourceSize, int64_t sourceMtime,
+                      SyncPolicy policy = SyncPolicy::FileAndDirectory)
+    {
+        vector<SnapshotRecipe> recipeTable;
+        vector<SnapshotIngredient> ingredientTable;
+        string strings;
+        unordered_map<string_view, uint64_t> interned; // 키는 레시피 데이터를 가리키므로 이 함수 안에서만 유효
+
+        auto addString = [&](string_view s) {
+            auto it = interned.find(s);
+            if (it != interned.end())
+                return it->second;
+            uint64_t offset = strings.size();
+            strings += s;
+            interned.emplace(s, offset);
+            return offset;
+        };
+
+        recipeTable.reserve(recipes.size());
+        for (const auto &recipe : recipes)
+        {
+            SnapshotRecipe record{};
+            record.titleOffset = addString(recipe.getTitle());
+            record.titleLength = static_cast<uint32_t>(recipe.getTitle().size());
+            // 조리 절차는 레시피마다 다르므로 중복 제거 없이 이어 붙입니다. (지연 로딩 중이어도 캐시하지 않고 읽음)
+            record.procedureOffset = strings.size();
+            recipe.appendProcedureTo(strings);
+            record.procedureLength = static_cast<uint32_t>(strings.size() - record.procedureOffset);
+            record.ingredientFirst = static_cast<uint32_t>(ingredientTable.size());
+            record.ingredientCount = static_cast<uint32_t>(recipe.getIngredient().size());
+            record.time = recipe.getTime();
+            record.difficulty = static_cast<uint32_t>(recipe.getDifficulty());
+            for (const auto &ing : recipe.getIngredient())
+            {
+                SnapshotIngredient item{};
+                const string &name = recipe.ingredientName(ing);
+                const string &unit = recipe.ingredientUnit(ing);
+                item.nameOffset = addString(name);
+                item.nameLength = static_cast<uint32_t>(name.size());
+                item.unitOffset = addString(unit);
+                item.unitLength = static_cast<uint32_t>(unit.size());
+                item.quantity = ing.quantity;
+                ingredientTable.push_back(item);
+            }
+            recipeTable.push_back(record);
+        }
+
+        SnapshotHeader header{};
+        memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kVersion;
+        header.byteOrderMark = kByteOrderMark;
+        header.recipeCount = recipeTable.size();
+        header.ingredientCount = ingredientTable.size();
+        header.recipeTableOffset = sizeof(SnapshotHeader);
+        header.ingredientTableOffset = header.recipeTableOffset + recipeTable.size() * sizeof(SnapshotRecipe);
+        header.stringTableOffset = header.ingredientTableOffset + ingredientTable.size() * sizeof(SnapshotIngredient);
+        header.stringTableSize = strings.size();
+        header.sourceSize = sourceSize;
+        header.sourceMtime = sourceMtime;
+
+        // 지연 로딩 중인 데이터베이스가 기존 스냅샷을 매핑하고 있을 수 있으므로, 제자리에서 덮어쓰지 않고 임시 파일을 rename으로 교체합니다.
+        return AtomicFile::write(path,
+                                 {string_view(reinterpret_cast<const char *>(&header), sizeof(header)),
+                                  string_view(reinterpret_cast<const char *>(recipeTable.data()), recipeTable.size() * sizeof(SnapshotRecipe)),
+                                  string_view(reinterpret_cast<const char *>(ingredientTable.data()), ingredientTable.size() * sizeof(SnapshotIngredient)),
+                                  strings},
+                                 policy)
+            .ok;
+    }
+
+    /*
+     * bool readHeader(string_view data, SnapshotHeader &header, string &error): 헤더를 읽고 모든 테이블이 파일 범위 안에 있는지 검사합니다.
+     * return 올바른 스냅샷이면 true, 아니면 false와 함께 error에 이유를 담습니다.
+     */
+    inline bool readHeader(string_view data, SnapshotHeader &header, string &error)
+    {
+        if (data.size() < sizeof(SnapshotHeader))
+        {
+            error = "file is too small to be a snapshot";
+            return false;
+        }
+        memcpy(&header, data.data(), sizeof(header));
+        if (memcmp(header.magic, kMagic, sizeof(kMagic)) != 0)
+        {
+            error = "bad magic (not a recipe snapshot)";
+            return false;
+        }
+        if (header.byteOrderMark != kByteOrderMark)
+        {
+            error = "snapshot was written on a machine with a different byte order";
+            return false;
+        }
+        if (header.version != kVersion)
+        {
+            error = "unsupported snapshot version " + to_string(header.version);
+            return false;
+        }
+        // 곱셈 오버플로를 피하기 위해 개수를 먼저 파일 크기와 비교합니다.
+        if (header.recipeCount > data.size() / sizeof(SnapshotRecipe) ||
+            header.ingredientCount > data.size() / sizeof(SnapshotIngredient) ||
+            header.recipeTableOffset > data.size() ||
+            data.size() - header.recipeTableOffset < header.recipeCount * sizeof(SnapshotRecipe) ||
+            header.ingredientTableOffset > data.size() ||
+            data.size() - header.ingredientTableOffset < header.ingredientCount * sizeof(SnapshotIngredient) ||
+            header.stringTableOffset > data.size() ||
+            data.size() - header.stringTableOffset < header.stringTableSize)
+        {
+            error = "snapshot is truncated or its tables are out of range";
+            return false;
+        }
+        return true;
+    }
+
+    /*
+     * bool read(const string &path, vector<Recipe> &out, string &error, const shared_ptr<SymbolTable> &symbols,
+     *           const shared_ptr<TextArena> &textArena, bool lazyProcedures = false):
+     * 스냅샷 파일을 읽어 out에 레시피를 추가합니다. 재료 이름/단위는 symbols에 인터닝하고, 제목/조리 절차는 textArena에 복사합니다.
+     * details: 파일을 한 번 매핑한 뒤 고정 크기 레코드를 차례로 읽어 문자열 테이블의 구간을 그대로 Recipe에 복사합니다.
+     * 문자열 테이블은 이미 중복이 제거되어 있으므로, 같은 위치(offset)의 문자열은 한 번만 인터닝합니다.
+     * lazyProcedures가 true이면 조리 절차는 복사하지 않고 매핑을 유지한 채 위치만 기록합니다.
+     * 범위를 벗어난 레코드가 하나라도 있으면 out을 건드리지 않고 실패합니다.
+     * return 성공 시 true, 실패 시 false와 함께 error에 이유를 담습니다.
+     */
+    inline bool read(const string &path, vector<Recipe> &out, string &error, const shared_ptr<SymbolTable> &symbols,
+                     const shared_ptr<TextArena> &textArena, bool lazyProcedures = false)
+    {
+        MappedFile file;
+        if (!file.open(path))
+        {
+            error = "cannot open " + path;
+            return false;
+        }
+        shared_ptr<ProcedureSource> source;
+        if (lazyProcedures)
+            source = make_shared<ProcedureSource>(std::move(file), false);
+        string_view data = source ? source->view() : file.view();
+        SnapshotHeader header;
+        if (!readHeader(data, header, error))
+            return false;
+
+        string_view strings = data.substr(header.stringTableOffset, header.stringTableSize);
+        auto stringAt = [&](uint64_t offset, uint32_t length, string_view &result) {
+            if (offset > strings.size() || strings.size() - offset < length)
+                return false;
+            result = strings.substr(offset, length);
+            return true;
+        };
+
+        unordered_map<uint64_t, uint32_t> symbolAt; // 문자열 테이블 위치 -> 심볼 id
+        auto symbolFor = [&](uint64_t offset, string_view text) {
+            auto it = symbolAt.find(offset);
+            if (it != symbolAt.end())
+                return it->second;
+            uint32_t id = symbols->intern(text);
+            symbolAt.emplace(offset, id);
+            return id;
+        };
+
+        vector<Recipe> loaded;
+        loaded.reserve(header.recipeCount);
+        for (uint64_t i = 0; i < header.recipeCount; i++)
+        {
+            SnapshotRecipe record;
+            memcpy(&record, data.data() + header.recipeTableOffset + i * sizeof(SnapshotRecipe), sizeof(record));
+
+            string_view title, procedure;
+            if (!stringAt(record.titleOffset, record.titleLength, title) ||
+                !stringAt(record.procedureOffset, record.procedureLength, procedure) ||
+                record.ingredientFirst > header.ingredientCount ||
+                header.ingredientCount - record.ingredientFirst < record.ingredientCount ||
+                record.difficulty > 2)
+            {
+                error = "corrupt recipe record #" + to_string(i);
+                return false;
+            }
+
+            vector<Ingredient> ingredients(record.ingredientCount);
+            for (uint32_t j = 0; j < record.ingredientCount; j++)
+            {
+                SnapshotIngredient item;
+                memcpy(&item, data.data() + header.ingredientTableOffset + (uint64_t(record.ingredientFirst) + j) * sizeof(SnapshotIngredient), sizeof(item));
+                string_view name, unit;
+                if (!stringAt(item.nameOffset, item.nameLength, name) || !stringAt(item.unitOffset, item.unitLength, unit))
+                {
+                    error = "corrupt ingredient record in recipe #" + to_string(i);
+                    return false;
+                }
+                ingredients[j].nameId = symbolFor(item.nameOffset, name);
+                ingredients[j].quantity = item.quantity;
+                ingredients[j].unitId = symbolFor(item.unitOffset, unit);
+            }
+
+            if (source && !procedure.empty())
+                loaded.emplace_back(title, source, header.stringTableOffset + record.procedureOffset, record.procedureLength,
+                                    record.time, std::move(ingredients), static_cast<Difficulty>(record.difficulty), symbols, textArena);
+            else
+                loaded.emplace_back(title, procedure, record.time, std::move(ingredients), static_cast<Difficulty>(record.difficulty), symbols, textArena);
+        }
+
+        if (source)
+            source->dropResidentPages();
+        out.insert(out.end(), make_move_iterator(loaded.begin()), make_move_iterator(loaded.end()));
+        return true;
+    }
+
+    /*
+     * bool readSourceInfo(const string &path, uint64_t &sourceSize, int64_t &sourceMtime): 헤더만 읽어 원본 텍스트 파일 정보를 가져옵니다.
+     * details: 스냅샷이 현재 Recipe.txt보다 오래되었는지 확인할 때 사용합니다.
+     */
+    inline bool readSourceInfo(const string &path, uint64_t &sourceSize, int64_t &sourceMtime)
+    {
+        ifstream file(path, ios::binary);
+        SnapshotHeader header;
+        if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)))
+            return false;
+        if (memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.byteOrderMark != kByteOrderMark || header.version != kVersion)
+            return false;
+        sourceSize = header.sourceSize;
+        sourceMtime = header.sourceMtime;
+        return true;
+    }
+}
+
+#endif // RECIPE_SNAPSHOT_H
@@ -0,0 +1,431 @@
+#ifndef ROW_BITMAP_H
+#define ROW_BITMAP_H
+
+#include <algorithm> // std::sort, std::unique, std::lower_bound, std::set_intersection 등
+#include <cstddef>   // ptrdiff_t
+#include <cstdint>   // uint16_t, uint32_t, uint64_t
+#include <iterator>  // std::back_inserter, std::forward_iterator_tag
+#include <vector>
+#include "BitOps.h" // popcount, lowestBit
+
+using namespace std;
+
+/**
+ * RowBitmap 클래스
+ * --------------------------
+ * 행 번호(uint32_t) 집합을 담는 압축 비트맵. (Roaring bitmap과 같은 구조)
+ * - 행 번호의 상위 16비트(key)마다 "컨테이너" 하나를 두고, 하위 16비트만 저장합니다.
+ * - 원소가 kArrayMax(4096)개 이하인 컨테이너는 정렬된 uint16 배열(최대 8KB), 그보다 많으면 65536비트 비트맵(8KB)으로 둡니다.
+ * 따라서 드문 집합은 원소 수에 비례하는 공간만 쓰고, 촘촘한 집합은 비트당 1비트를 씁니다.
+ *
+ * 교집합/합집합/차집합은 같은 key의 컨테이너끼리만 계산하며, 컨테이너 종류(배열/비트맵) 조합마다
+ * 병합, 탐색, 워드 단위 AND/OR 중 알맞은 방법을 씁니다. 원소는 항상 오름차순으로 꺼냅니다.
+ */
+class RowBitmap
+{
+private:
+    static constexpr size_t kArrayMax = 4096;  // 이보다 많으면 비트맵 컨테이너
+    static constexpr size_t kBitmapWords = 1024; // 65536비트
+
+    struct Container
+    {
+        uint16_t key = 0;
+        uint32_t cardinality = 0;
+        vector<uint16_t> array; // 배열 컨테이너: 오름차순 하위 16비트
+        vector<uint64_t> words; // 비트맵 컨테이너: kBitmapWords개 (배열 컨테이너면 비어 있음)
+
+        bool isBitmap() const { return !words.empty(); }
+        bool contains(uint16_t low) const
+        {
+            if (isBitmap())
+                return (words[low >> 6] >> (low & 63)) & 1;
+            return binary_search(array.begin(), array.end(), low);
+        }
+    };
+
+    vector<Container> containers; // key 오름차순, 빈 컨테이너는 두지 않음
+
+    // 비트맵 컨테이너의 원소가 적어졌으면 배열 컨테이너로 바꿉니다.
+    static void shrink(Container &c)
+    {
+        if (!c.isBitmap() || c.cardinality > kArrayMax)
+            return;
+        c.array.clear();
+        c.array.reserve(c.cardinality);
+        for (size_t w = 0; w < kBitmapWords; w++)
+        {
+            for (uint64_t bits = c.words[w]; bits; bits &= bits - 1)
+                c.array.push_back(static_cast<uint16_t>(w * 64 + BitOps::lowestBit(bits)));
+        }
+        c.words.clear();
+        c.words.shrink_to_fit();
+    }
+
+    static void toBitmap(Container &c)
+    {
+        if (c.isBitmap())
+            return;
+        c.words.assign(kBitmapWords, 0);
+        for (uint16_t low : c.array)
+            c.words[low >> 6] |= uint64_t(1) << (low & 63);
+        c.array.clear();
+        c.array.shrink_to_fit();
+    }
+
+    static Container intersect(const Container &a, const Container &b)
+    {
+        Container out;
+        out.key = a.key;
+        if (a.isBitmap() && b.isBitmap())
+        {
+            out.words.resize(kBitmapWords);
+            for (size_t w = 0; w < kBitmapWords; w++)
+            {
+                out.words[w] = a.words[w] & b.words[w];
+                out.cardinality += BitOps::popcount(out.words[w]);
+            }
+            shrink(out);
+        }
+        else if (a.isBitmap() || b.isBitmap())
+        {
+            // 배열의 원소마다 비트맵에 있는지 확인
+            const Container &arr = a.isBitmap() ? b : a;
+            const Container &bits = a.isBitmap() ? a : b;
+            for (uint16_t low : arr.array)
+            {
+                if (bits.contains(low))
+                    out.array.push_back(low);
+            }
+            out.cardinality = static_cast<uint32_t>(out.array.size());
+        }
+        else
+        {
+            set_intersection(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), back_inserter(out.array));
+            out.cardinality = static_cast<uint32_t>(out.array.size());
+        }
+        return out;
+    }
+
+    static Container unite(const Container &a, const Container &b)
+    {
+        Container out;
+        out.key = a.key;
+        if (!a.isBitmap() && !b.isBitmap() && a.cardinality + b.cardinality <= kArrayMax)
+        {
+            set_union(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), back_inserter(out.array));
+            out.cardinality = static_cast<uint32_t>(out.array.size());
+            return out;
+        }
+        out = a;
+        toBitmap(out);
+        if (b.isBitmap())
+        {
+            for (size_t w = 0; w < kBitmapWords; w++)
+                out.words[w] |= b.words[w];
+        }
+        else
+        {
+            for (uint16_t low : b.array)
+                out.words[low >> 6] |= uint64_t(1) << (low & 63);
+        }
+        out.cardinality = 0;
+        for (uint64_t word : out.words)
+            out.cardinality += BitOps::popcount(word);
+        shrink(out);
+        return out;
+    }
+
+    static Container subtract(const Container &a, const Container &b)
+    {
+        Container out;
+        out.key = a.key;
+        if (!a.isBitmap())
+        {
+            // 배열에서 b에 없는 원소만 남김
+            if (b.isBitmap())
+            {
+                for (uint16_t low : a.array)
+                {
+                    if (!b.contains(low))
+                        out.array.push_back(low);
+                }
+            }
+            else
+            {
+                set_difference(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), back_inserter(out.array));
+            }
+            out.cardinality = static_cast<uint32_t>(out.array.size());
+            return out;
+        }
+        out = a;
+        if (b.isBitmap())
+        {
+            out.cardinality = 0;
+            for (size_t w = 0; w < kBitmapWords; w++)
+            {
+                out.words[w] &= ~b.words[w];
+                out.cardinality += BitOps::popcount(out.words[w]);
+            }
+        }
+        else
+        {
+            for (uint16_t low : b.array)
+            {
+                uint64_t bit = uint64_t(1) << (low & 63);
+                if (out.words[low >> 6] & bit)
+                {
+                    out.words[low >> 6] &= ~bit;
+                    out.cardinality--;
+                }
+            }
+        }
+        shrink(out);
+        return out;
+    }
+
+public:
+    /*
+     * static RowBitmap fromSortedRows(const vector<uint32_t> &rows): 오름차순(중복 없음) 행 번호로 비트맵을 만듭니다.
+     * static RowBitmap fromRows(vector<uint32_t> rows): 순서 상관없는 행 번호로 만듭니다. (정렬 + 중복 제거 후 fromSortedRows)
+     */
+    static RowBitmap fromSortedRows(const vector<uint32_t> &rows)
+    {
+        RowBitmap bitmap;
+        size_t i = 0;
+        while (i < rows.size())
+        {
+            Container c;
+            c.key = static_cast<uint16_t>(rows[i] >> 16);
+            size_t end = i;
+            while (end < rows.size() && (rows[end] >> 16) == c.key)
+                end++;
+            c.cardinality = static_cast<uint32_t>(end - i);
+            if (c.cardinality > kArrayMax)
+            {
+                c.words.assign(kBitmapWords, 0);
+                for (; i < end; i++)
+                    c.words[(rows[i] & 0xFFFF) >> 6] |= uint64_t(1) << (rows[i] & 63);
+            }
+            else
+            {
+                c.array.reserve(c.cardinality);
+                for (; i < end; i++)
+                    c.array.push_back(static_cast<uint16_t>(rows[i] & 0xFFFF));
+            }
+            bitmap.containers.push_back(std::move(c));
+        }
+        return bitmap;
+    }
+    static RowBitmap fromRows(vector<uint32_t> rows)
+    {
+        sort(rows.begin(), rows.end());
+        rows.erase(unique(rows.begin(), rows.end()), rows.end());
+        return fromSortedRows(rows);
+    }
+
+    // [0, rowCount) 전체
+    static RowBitmap allRows(uint32_t rowCount)
+    {
+        RowBitmap bitmap;
+        for (uint32_t start = 0; start < rowCount; start += 65536)
+        {
+            Container c;
+            c.key = static_cast<uint16_t>(start >> 16);
+            c.cardinality = min<uint32_t>(65536, rowCount - start);
+            c.words.assign(kBitmapWords, 0);
+            for (uint32_t low = 0; low < c.cardinality; low += 64)
+                c.words[low >> 6] = c.cardinality - low >= 64 ? ~uint64_t(0) : (uint64_t(1) << (c.cardinality - low)) - 1;
+            shrink(c);
+            bitmap.containers.push_back(std::move(c));
+        }
+        return bitmap;
+    }
+
+    bool empty() const { return containers.empty(); }
+
+    // 원소 개수 (컨테이너마다 저장해 둔 개수의 합이므로 원소를 꺼내지 않음)
+    size_t count() const
+    {
+        size_t total = 0;
+        for (const auto &c : containers)
+            total += c.cardinality;
+        return total;
+    }
+
+    bool contains(uint32_t row) const
+    {
+        uint16_t key = static_cast<uint16_t>(row >> 16);
+        auto it = lower_bound(containers.begin(), containers.end(), key,
+                              [](const Container &c, uint16_t k) { return c.key < k; });
+        return it != containers.end() && it->key == key && it->contains(static_cast<uint16_t>(row & 0xFFFF));
+    }
+
+    /*
+     * RowBitmap& intersectWith / uniteWith / subtract(const RowBitmap &other): 이 비트맵을 this ∩ other / this ∪ other / this - other로 바꿉니다.
+     */
+    RowBitmap &intersectWith(const RowBitmap &other)
+    {
+        vector<Container> out;
+        size_t i = 0, j = 0;
+        while (i < containers.size() && j < other.containers.size())
+        {
+            if (containers[i].key < other.containers[j].key)
+                i++;
+            else if (containers[i].key > other.containers[j].key)
+                j++;
+            else
+            {
+                Container c = intersect(containers[i++], other.containers[j++]);
+                if (c.cardinality)
+                    out.push_back(std::move(c));
+            }
+        }
+        containers = std::move(out);
+        return *this;
+    }
+    RowBitmap &uniteWith(const RowBitmap &other)
+    {
+        vector<Container> out;
+        size_t i = 0, j = 0;
+        while (i < containers.size() || j < other.containers.size())
+        {
+            if (j == other.containers.size() || (i < containers.size() && containers[i].key < other.containers[j].key))
+                out.push_back(std::move(containers[i++]));
+            else if (i == containers.size() || containers[i].key > other.containers[j].key)
+                out.push_back(other.containers[j++]);
+            else
+                out.push_back(unite(containers[i++], other.containers[j++]));
+        }
+        containers = std::move(out);
+        return *this;
+    }
+    RowBitmap &subtract(const RowBitmap &other)
+    {
+        vector<Container> out;
+        size_t j = 0;
+        for (auto &c : containers)
+        {
+            while (j < other.containers.size() && other.containers[j].key < c.key)
+                j++;
+            if (j == other.containers.size() || other.containers[j].key != c.key)
+            {
+                out.push_back(std::move(c));
+                continue;
+            }
+            Container rest = subtract(c, other.containers[j]);
+            if (rest.cardinality)
+                out.push_back(std::move(rest));
+        }
+        containers = std::move(out);
+        return *this;
+    }
+
+    /*
+     * void forEach(Visitor visit) const: 원소(행 번호)마다 visit(row)를 오름차순으로 호출합니다.
+     */
+    template <typename Visitor>
+    void forEach(Visitor visit) const
+    {
+        for (const auto &c : containers)
+        {
+            uint32_t base = static_cast<uint32_t>(c.key) << 16;
+            if (c.isBitmap())
+            {
+                for (size_t w = 0; w < kBitmapWords; w++)
+                {
+                    for (uint64_t bits = c.words[w]; bits; bits &= bits - 1)
+                        visit(base + static_cast<uint32_t>(w * 64 + BitOps::lowestBit(bits)));
+                }
+            }
+            else
+            {
+                for (uint16_t low : c.array)
+                    visit(base + low);
+            }
+        }
+    }
+
+    /*
+     * const_iterator: 원소를 필요할 때 하나씩 꺼내는 전진 반복자. (전체 목록을 미리 만들지 않음)
+     * details: 반복하는 동안 비트맵을 바꾸면 안 됩니다.
+     */
+    class const_iterator
+    {
+    private:
+        const RowBitmap *bitmap = nullptr;
+        size_t container = 0; // containers.size()이면 끝
+        size_t position = 0;  // 배열 컨테이너: 배열 위치 / 비트맵 컨테이너: 워드 위치
+        uint64_t bits = 0;    // 비트맵 컨테이너: 현재 워드에서 아직 꺼내지 않은 비트
+
+        // 현재 위치가 원소를 가리키도록 빈 워드/컨테이너를 건너뜁니다.
+        void settle()
+        {
+            const auto &cs = bitmap->containers;
+            while (container < cs.size())
+            {
+                const Container &c = cs[container];
+                if (!c.isBitmap())
+                {
+                    if (position < c.array.size())
+                        return;
+                }
+                else
+                {
+                    while (bits == 0 && ++position < kBitmapWords)
+                        bits = c.words[position];
+                    if (bits)
+                        return;
+                }
+                container++;
+                position = 0;
+                bits = container < cs.size() && cs[container].isBitmap() ? cs[container].words[0] : 0;
+            }
+        }
+
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = uint32_t;
+        using difference_type = ptrdiff_t;
+        using pointer = const uint32_t *;
+        using reference = uint32_t;
+
+        const_iterator() = default;
+        const_iterator(const RowBitmap *bitmap, size_t container) : bitmap(bitmap), container(container)
+        {
+            if (container < bitmap->containers.size())
+            {
+                if (bitmap->containers[container].isBitmap())
+                    bits = bitmap->containers[container].words[0];
+                settle();
+            }
+        }
+
+        uint32_t operator*() const
+        {
+            const Container &c = bitmap->containers[container];
+            uint32_t base = static_cast<uint32_t>(c.key) << 16;
+            if (!c.isBitmap())
+                return base + c.array[position];
+            return base + static_cast<uint32_t>(position * 64 + BitOps::lowestBit(bits));
+        }
+        const_iterator &operator++()
+        {
+            if (!bitmap->containers[container].isBitmap())
+                position++;
+            else
+                bits &= bits - 1;
+            settle();
+            return *this;
+        }
+        bool operator==(const const_iterator &other) const
+        {
+            return container == other.container && position == other.position && bits == other.bits;
+        }
+        bool operator!=(const const_iterator &other) const { return !(*this == other); }
+    };
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, containers.size()); }
+};
+
+#endif // ROW_BITMAP_H
@@ -0,0 +1,81 @@
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <string>        // std::string: 심볼 문자열 보관
+#include <string_view>   // std::string_view: 조회 시 임시 문자열을 만들지 않기 위해 포함
+#include <deque>         // std::deque: 원소를 추가해도 기존 문자열의 주소가 바뀌지 않음
+#include <unordered_map> // 문자열 -> id 조회
+#include <vector>
+#include <cstdint>       // uint32_t
+
+using namespace std;
+
+/**
+ * SymbolTable 클래스
+ * --------------------------
+ * 재료 이름과 단위처럼 같은 값이 반복되는 문자열을 한 번만 저장하고, 작은 정수 id로 바꿔 주는 표(인터닝).
+ * - intern("cup")은 처음이면 새 id를, 이미 있으면 같은 id를 돌려줍니다.
+ * - id는 추가된 순서대로 0, 1, 2, ... 이며 한 번 정해지면 바뀌지 않습니다. (삭제 없음)
+ * - 같은 표에서 나온 id끼리는 정수 비교만으로 문자열이 같은지 알 수 있습니다.
+ *
+ * 문자열은 deque에 보관하므로 원소가 늘어나도 기존 문자열이 옮겨지지 않고,
+ * 조회용 해시 맵의 키(string_view)가 그 문자열을 직접 가리킬 수 있습니다.
+ */
+class SymbolTable
+{
+private:
+    deque<string> symbols;                   // id -> 문자열
+    unordered_map<string_view, uint32_t> ids; // 문자열 -> id (키는 symbols의 원소를 가리킴)
+
+public:
+    SymbolTable() = default;
+
+    // 키가 자신의 deque를 가리키므로 복사/이동하면 안 됩니다. (RecipeDatabase가 shared_ptr로 공유)
+    SymbolTable(const SymbolTable &) = delete;
+    SymbolTable &operator=(const SymbolTable &) = delete;
+
+    /*
+     * uint32_t intern(string_view text): text의 id를 반환합니다. 처음 보는 문자열이면 표에 추가합니다.
+     */
+    uint32_t intern(string_view text)
+    {
+        auto it = ids.find(text);
+        if (it != ids.end())
+            return it->second;
+        uint32_t id = static_cast<uint32_t>(symbols.size());
+        symbols.emplace_back(text);
+        ids.emplace(string_view(symbols.back()), id);
+        return id;
+    }
+
+    /*
+     * bool find(string_view text, uint32_t &id) const: 표에 이미 있는 문자열이면 id를 담고 true를 반환합니다. (추가하지 않음)
+     */
+    bool find(string_view text, uint32_t &id) const
+    {
+        auto it = ids.find(text);
+        if (it == ids.end())
+            return false;
+        id = it->second;
+        return true;
+    }
+
+    const string &name(uint32_t id) const { return symbols[id]; }
+    size_t size() const { return symbols.size(); }
+    // 심볼이 대략 몇 개 생길지 알 때 해시 표를 미리 늘려 둡니다. (추가 도중 재해싱 방지)
+    void reserve(size_t expected) { ids.reserve(expected); }
+
+    /*
+     * vector<uint32_t> merge(const SymbolTable &other): other의 모든 심볼을 이 표에 추가하고, other id -> 이 표 id 변환표를 반환합니다.
+     * details: 여러 스레드가 각자의 표로 파싱한 결과를 하나로 합칠 때 사용합니다.
+     */
+    vector<uint32_t> merge(const SymbolTable &other)
+    {
+        vector<uint32_t> remap(other.size());
+        for (uint32_t id = 0; id < other.size(); id++)
+            remap[id] = intern(other.name(id));
+        return remap;
+    }
+};
+
+#endif // SYMBOL_TABLE_H
@@ -0,0 +1,138 @@
+#ifndef TEXT_ARENA_H
+#define TEXT_ARENA_H
+
+#include <cstddef>     // size_t
+#include <cstring>     // memcpy
+#include <iterator>    // std::make_move_iterator
+#include <memory>      // std::unique_ptr: 블록 메모리 소유
+#include <string_view> // 저장한 문자열을 뷰로 돌려줌
+#include <vector>
+
+using namespace std;
+
+/**
+ * TextArena 클래스
+ * --------------------------
+ * 레시피 제목/조리 절차 같은 문자열을 큰 블록에 차례로 붙여 저장하는 bump 할당기.
+ * - store(text)는 현재 블록 끝에 text를 복사하고 그 위치의 string_view를 돌려줍니다. (문자열마다 malloc 없음)
+ * - 블록이 가득 차면 새 블록을 만듭니다. 블록 크기는 4KB에서 시작해 1MB까지 두 배씩 커집니다.
+ * - 개별 문자열은 해제할 수 없습니다. release(text)는 '더 이상 쓰지 않음'으로 집계만 하고,
+ *   쓰레기가 많이 쌓이면 살아있는 문자열만 새 아레나로 옮기는 압축(compaction)으로 회수합니다.
+ * - 아레나가 사라질 때 블록 몇 개만 해제하므로, 큰 데이터베이스도 빠르게 정리됩니다.
+ *
+ * 저장된 문자열의 주소는 아레나가 살아있는 동안 바뀌지 않습니다. (블록을 옮기지 않음)
+ */
+class TextArena
+{
+private:
+    static constexpr size_t kFirstBlock = 4u << 10; // 4KB
+    static constexpr size_t kMaxBlock = 1u << 20;   // 1MB (이보다 큰 문자열은 전용 블록)
+
+    struct Block
+    {
+        unique_ptr<char[]> data;
+        size_t capacity;
+        size_t used;
+    };
+    vector<Block> blocks;
+    size_t nextBlockSize = kFirstBlock;
+
+    size_t usedBytes = 0;     // 지금까지 저장한 전체 바이트 (쓰레기 포함)
+    size_t liveBytes = 0;     // usedBytes - release()된 바이트
+    size_t reservedBytes = 0; // 블록 용량 합계 (실제 점유 메모리)
+    size_t peakReservedBytes = 0;
+
+    char *allocate(size_t length)
+    {
+        if (blocks.empty() || blocks.back().capacity - blocks.back().used < length)
+        {
+            size_t capacity = length > nextBlockSize ? length : nextBlockSize;
+            blocks.push_back(Block{unique_ptr<char[]>(new char[capacity]), capacity, 0});
+            reservedBytes += capacity;
+            if (reservedBytes > peakReservedBytes)
+                peakReservedBytes = reservedBytes;
+            if (nextBlockSize < kMaxBlock)
+                nextBlockSize *= 2;
+        }
+        Block &block = blocks.back();
+        char *p = block.data.get() + block.used;
+        block.used += length;
+        return p;
+    }
+
+public:
+    TextArena() = default;
+    // 용량을 미리 알고 있으면(압축 등) 첫 블록을 그 크기로 만듭니다.
+    explicit TextArena(size_t expectedBytes)
+    {
+        if (expectedBytes > kFirstBlock)
+            nextBlockSize = expectedBytes;
+    }
+
+    TextArena(const TextArena &) = delete;
+    TextArena &operator=(const TextArena &) = delete;
+
+    /*
+     * string_view store(string_view text): text를 아레나에 복사하고, 복사본을 가리키는 뷰를 반환합니다.
+     */
+    string_view store(string_view text)
+    {
+        if (text.empty())
+            return string_view();
+        char *p = allocate(text.size());
+        memcpy(p, text.data(), text.size());
+        usedBytes += text.size();
+        liveBytes += text.size();
+        return string_view(p, text.size());
+    }
+
+    /*
+     * string_view storeTransformed(string_view text, Transform transform): text의 각 바이트에 transform을 적용하며 복사합니다.
+     * details: 소문자 검색 키처럼 원본에서 바로 만들어지는 파생 문자열을 임시 string 없이 아레나에 만들 때 사용합니다.
+     */
+    template <typename Transform>
+    string_view storeTransformed(string_view text, Transform transform)
+    {
+        if (text.empty())
+            return string_view();
+        char *p = allocate(text.size());
+        for (size_t i = 0; i < text.size(); i++)
+            p[i] = transform(text[i]);
+        usedBytes += text.size();
+        liveBytes += text.size();
+        return string_view(p, text.size());
+    }
+
+    // text가 더 이상 쓰이지 않음을 집계합니다. (메모리는 압축 때 회수)
+    void release(string_view text)
+    {
+        liveBytes -= text.size() <= liveBytes ? text.size() : liveBytes;
+    }
+
+    /*
+     * void absorb(TextArena &other): other의 블록을 모두 넘겨받습니다. 문자열의 주소는 바뀌지 않습니다.
+     * details: 여러 스레드가 각자의 아레나에 파싱한 뒤 하나로 합칠 때 사용합니다. other는 빈 아레나가 됩니다.
+     */
+    void absorb(TextArena &other)
+    {
+        // 넘겨받은 블록을 현재 블록 앞에 두어, 현재 블록의 남은 공간을 계속 쓸 수 있게 합니다.
+        blocks.insert(blocks.end() - (blocks.empty() ? 0 : 1),
+                      make_move_iterator(other.blocks.begin()), make_move_iterator(other.blocks.end()));
+        usedBytes += other.usedBytes;
+        liveBytes += other.liveBytes;
+        reservedBytes += other.reservedBytes;
+        if (reservedBytes > peakReservedBytes)
+            peakReservedBytes = reservedBytes;
+        other.blocks.clear();
+        other.usedBytes = other.liveBytes = other.reservedBytes = 0;
+    }
+
+    size_t getUsedBytes() const { return usedBytes; }
+    size_t getLiveBytes() const { return liveBytes; }
+    size_t getGarbageBytes() const { return usedBytes - liveBytes; }
+    size_t getReservedBytes() const { return reservedBytes; }
+    size_t getPeakReservedBytes() const { return peakReservedBytes; }
+    size_t getBlockCount() const { return blocks.size(); }
+};
+
+#endif // TEXT_ARENA_H
@@ -0,0 +1,186 @@
+#ifndef TEXT_SCAN_H
+#define TEXT_SCAN_H
+
+#include <cstddef>     // size_t
+#include <cstring>     // std::memchr
+#include <string_view>
+#include "BitOps.h" // lowestBit
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TEXT_SCAN_SSE2 1
+#include <emmintrin.h> // SSE2
+#endif
+#if TEXT_SCAN_SSE2 && (defined(__GNUC__) || defined(__clang__))
+#define TEXT_SCAN_AVX2 1 // target 속성으로 AVX2 함수만 따로 컴파일하고, 실행할 때 CPU를 확인해 고름
+#include <immintrin.h> // AVX2
+#endif
+
+using namespace std;
+
+/**
+ * TextScan 클래스
+ * --------------------------
+ * 이어 붙인 큰 문자열(모든 제목, 모든 재료 이름 등)에서 대소문자를 구분하지 않고 부분 문자열을 찾는 스캔 함수.
+ * - 대소문자는 ASCII A-Z만 같게 보고(Recipe::foldChar와 같은 규칙), 0x80 이상 바이트는 그대로 비교합니다.
+ *   UTF-8의 첫 바이트와 이어지는 바이트는 값이 겹치지 않으므로, 올바른 UTF-8 문자열은 문자 경계에서만 일치합니다.
+ * - 찾는 문자열(needle)은 이미 소문자여야 합니다. (Recipe::foldKey)
+ *
+ * 벡터 커널은 needle의 첫 바이트와 마지막 바이트를 16/32바이트씩 한 번에 비교해 둘 다 맞는 위치만 나머지를 확인합니다.
+ * 글자(a-z)는 0x20 비트를 켠 값으로 비교하므로 대문자도 함께 걸립니다.
+ * 실행할 때 한 번 AVX2(32바이트) -> SSE2(16바이트) -> 스칼라 순으로 쓸 수 있는 것을 고릅니다.
+ */
+class TextScan
+{
+public:
+    // (text, n)에서 from 이후 처음으로 (needle, m)이 나오는 위치, 없으면 npos
+    using Kernel = size_t (*)(const char *text, size_t n, const char *needle, size_t m, size_t from);
+    static constexpr size_t npos = string_view::npos;
+
+private:
+    static char fold(char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c; }
+    static bool isLetter(char c) { return c >= 'a' && c <= 'z'; }
+
+    // text[0..m)을 소문자로 바꾼 것이 needle[0..m)과 같은지
+    static bool equalFolded(const char *text, const char *needle, size_t m)
+    {
+        for (size_t k = 0; k < m; k++)
+        {
+            if (fold(text[k]) != needle[k])
+                return false;
+        }
+        return true;
+    }
+
+    static Kernel selectKernel()
+    {
+#if TEXT_SCAN_AVX2
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return findAvx2;
+#endif
+#if TEXT_SCAN_SSE2
+        return findSse2;
+#else
+        return findScalar;
+#endif
+    }
+
+public:
+    static size_t findScalar(const char *text, size_t n, const char *needle, size_t m, size_t from)
+    {
+        if (m == 0)
+            return from <= n ? from : npos;
+        if (m > n)
+            return npos;
+        char first = needle[0];
+        if (!isLetter(first))
+        {
+            // 첫 바이트가 글자가 아니면 memchr로 후보를 건너뜀
+            for (size_t i = from; i + m <= n;)
+            {
+                const void *hit = memchr(text + i, first, n - m + 1 - i);
+                if (!hit)
+                    return npos;
+                i = static_cast<size_t>(static_cast<const char *>(hit) - text);
+                if (equalFolded(text + i + 1, needle + 1, m - 1))
+                    return i;
+                i++;
+            }
+            return npos;
+        }
+        for (size_t i = from; i + m <= n; i++)
+        {
+            if (fold(text[i]) == first && equalFolded(text + i + 1, needle + 1, m - 1))
+                return i;
+        }
+        return npos;
+    }
+
+#if TEXT_SCAN_SSE2
+    static size_t findSse2(const char *text, size_t n, const char *needle, size_t m, size_t from)
+    {
+        if (m == 0 || m > n || (m == 1 && !isLetter(needle[0])))
+            return findScalar(text, n, needle, m, from); // 글자가 아닌 한 바이트는 memchr가 더 빠름
+        // 글자면 0x20 비트를 켜서 비교 ('A' | 0x20 == 'a'), 아니면 그대로 비교
+        const __m128i firstCase = _mm_set1_epi8(isLetter(needle[0]) ? 0x20 : 0);
+        const __m128i lastCase = _mm_set1_epi8(isLetter(needle[m - 1]) ? 0x20 : 0);
+        const __m128i first = _mm_set1_epi8(needle[0]);
+        const __m128i last = _mm_set1_epi8(needle[m - 1]);
+        size_t i = from;
+        for (; i + m - 1 + 16 <= n; i += 16)
+        {
+            __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i));
+            __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i + m - 1));
+            __m128i hit = _mm_and_si128(_mm_cmpeq_epi8(_mm_or_si128(head, firstCase), first),
+                                        _mm_cmpeq_epi8(_mm_or_si128(tail, lastCase), last));
+            for (unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hit)); mask; mask &= mask - 1)
+            {
+                size_t at = i + BitOps::lowestBit(mask);
+                if (m <= 2 || equalFolded(text + at + 1, needle + 1, m - 2))
+                    return at;
+            }
+        }
+        return findScalar(text, n, needle, m, i);
+    }
+#endif
+
+#if TEXT_SCAN_AVX2
+    __attribute__((target("avx2"))) static size_t findAvx2(const char *text, size_t n, const char *needle, size_t m, size_t from)
+    {
+        if (m == 0 || m > n || (m == 1 && !isLetter(needle[0])))
+            return findScalar(text, n, needle, m, from);
+        const __m256i firstCase = _mm256_set1_epi8(isLetter(needle[0]) ? 0x20 : 0);
+        const __m256i lastCase = _mm256_set1_epi8(isLetter(needle[m - 1]) ? 0x20 : 0);
+        const __m256i first = _mm256_set1_epi8(needle[0]);
+        const __m256i last = _mm256_set1_epi8(needle[m - 1]);
+        size_t i = from;
+        for (; i + m - 1 + 32 <= n; i += 32)
+        {
+            __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(text + i));
+            __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(text + i + m - 1));
+            __m256i hit = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_or_si256(head, firstCase), first),
+                                           _mm256_cmpeq_epi8(_mm256_or_si256(tail, lastCase), last));
+            for (unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(hit)); mask; mask &= mask - 1)
+            {
+                size_t at = i + BitOps::lowestBit(mask);
+                if (m <= 2 || equalFolded(text + at + 1, needle + 1, m - 2))
+                    return at;
+            }
+        }
+        return findSse2(text, n, needle, m, i);
+    }
+#endif
+
+    // 이 CPU에서 쓰는 커널 (처음 호출할 때 한 번 고름)
+    static Kernel kernel()
+    {
+        static const Kernel selected = selectKernel();
+        return selected;
+    }
+
+    static const char *kernelName()
+    {
+#if TEXT_SCAN_AVX2
+        if (kernel() == findAvx2)
+            return "AVX2";
+#endif
+#if TEXT_SCAN_SSE2
+        if (kernel() == findSse2)
+            return "SSE2";
+#endif
+        return "scalar";
+    }
+
+    /*
+     * size_t findFolded(string_view text, string_view lowerNeedle, size_t from = 0): text의 from 이후에서
+     * 대소문자 구분 없이 lowerNeedle이 처음 나오는 위치를 찾습니다.
+     * return 위치, 없으면 npos
+     */
+    static size_t findFolded(string_view text, string_view lowerNeedle, size_t from = 0)
+    {
+        if (from > text.size())
+            return npos;
+        return kernel()(text.data(), text.size(), lowerNeedle.data(), lowerNeedle.size(), from);
+    }
+};
+
+#endif // TEXT_SCAN_H
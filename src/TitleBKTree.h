@@ -0,0 +1,271 @@
+#ifndef TITLE_BK_TREE_H
+#define TITLE_BK_TREE_H
+
+#include <algorithm>   // std::min, std::max
+#include <cstdint>     // uint32_t, uint64_t
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+/**
+ * TitleBKTree 클래스
+ * --------------------------
+ * (소문자로 바꾼) 제목 키를 편집 거리(Levenshtein, 바이트 단위)로 색인하는 BK-tree.
+ * - 각 노드는 서로 다른 키 하나와, 그 키를 가진 레시피 수(count)를 가집니다.
+ * - 자식은 부모와의 거리로 구분됩니다. 삼각 부등식에 의해 query와 거리 k 이내인 키는
+ *   |d(query, 노드) - 자식 거리| <= k인 자식 아래에만 있으므로, 나머지 가지는 거리 계산 없이 건너뜁니다.
+ *
+ * 키 삭제는 count만 줄입니다. (count가 0인 노드는 가지 역할만 하고 결과에 나오지 않음)
+ * 그런 빈 노드가 살아있는 노드보다 많아지면, 살아있는 키만으로 트리를 다시 만들어 노드와 키 바이트를 회수합니다.
+ * (TitleHashTable이 지운 칸이 쌓이면 다시 만드는 것과 같은 방식. 다시 만드는 비용은 그동안의 삭제 횟수로 나누면 상수)
+ * 거리는 비트 병렬 알고리즘(Myers/Hyyrö)으로 계산해, 64바이트 이하 키는 글자당 몇 번의 비트 연산으로 끝납니다.
+ */
+class TitleBKTree
+{
+private:
+    static constexpr uint32_t kNone = 0xFFFFFFFFu;
+
+    struct Node
+    {
+        uint32_t keyStart;
+        uint32_t keyLength;
+        uint32_t firstChild = kNone;
+        uint32_t nextSibling = kNone;
+        uint32_t distance = 0; // 부모와의 거리
+        uint32_t count = 0;    // 이 키를 가진 레시피 수
+    };
+
+    static constexpr size_t kMinRebuildNodes = 64; // 이보다 작은 트리는 다시 만들지 않음
+
+    string keys;        // 모든 노드의 키를 이어 붙인 문자열
+    vector<Node> nodes; // nodes[0]이 뿌리
+    size_t liveKeys = 0;
+
+    /*
+     * Pattern: 한 키(pattern)와 여러 키 사이의 편집 거리를 계산하는 도구. 작업(삽입/삭제/검색)마다 한 번 만듭니다.
+     * details: pattern이 64바이트 이하이면 바이트별 위치 비트마스크(peq)를 미리 만들어 비트 병렬로 계산하고,
+     *          더 길면 일반 동적 계획법(한 행씩)으로 계산합니다.
+     */
+    class Pattern
+    {
+    private:
+        string_view pattern;
+        uint64_t peq[256] = {};
+        mutable vector<uint32_t> row; // 긴 pattern용 동적 계획법 행
+
+    public:
+        explicit Pattern(string_view pattern) : pattern(pattern)
+        {
+            if (pattern.size() <= 64)
+            {
+                for (size_t i = 0; i < pattern.size(); i++)
+                    peq[static_cast<unsigned char>(pattern[i])] |= uint64_t(1) << i;
+            }
+        }
+
+        uint32_t distanceTo(string_view text) const
+        {
+            size_t m = pattern.size();
+            if (m == 0)
+                return static_cast<uint32_t>(text.size());
+            if (m <= 64)
+            {
+                uint64_t pv = ~uint64_t(0), mv = 0;
+                uint64_t last = uint64_t(1) << (m - 1);
+                uint32_t score = static_cast<uint32_t>(m);
+                for (char ch : text)
+                {
+                    uint64_t eq = peq[static_cast<unsigned char>(ch)];
+                    uint64_t xv = eq | mv;
+                    uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+                    uint64_t ph = mv | ~(xh | pv);
+                    uint64_t mh = pv & xh;
+                    if (ph & last)
+                        score++;
+                    else if (mh & last)
+                        score--;
+                    ph = (ph << 1) | 1; // 첫 행(빈 pattern과의 거리)은 글자마다 1씩 커짐
+                    mh <<= 1;
+                    pv = mh | ~(xv | ph);
+                    mv = ph & xv;
+                }
+                return score;
+            }
+            row.resize(m + 1);
+            for (size_t i = 0; i <= m; i++)
+                row[i] = static_cast<uint32_t>(i);
+            for (size_t j = 1; j <= text.size(); j++)
+            {
+                uint32_t diagonal = row[0];
+                row[0] = static_cast<uint32_t>(j);
+                for (size_t i = 1; i <= m; i++)
+                {
+                    uint32_t above = row[i];
+                    uint32_t cost = pattern[i - 1] == text[j - 1] ? 0 : 1;
+                    row[i] = min({row[i] + 1, row[i - 1] + 1, diagonal + cost});
+                    diagonal = above;
+                }
+            }
+            return row[m];
+        }
+    };
+
+    string_view keyOf(const Node &node) const { return string_view(keys).substr(node.keyStart, node.keyLength); }
+
+    uint32_t addNode(string_view key, uint32_t distance)
+    {
+        Node node;
+        node.keyStart = static_cast<uint32_t>(keys.size());
+        node.keyLength = static_cast<uint32_t>(key.size());
+        node.distance = distance;
+        keys += key;
+        nodes.push_back(node);
+        return static_cast<uint32_t>(nodes.size() - 1);
+    }
+
+    // key와 거리가 0인 노드, 없으면 kNone
+    uint32_t findNode(const Pattern &pattern) const
+    {
+        uint32_t current = nodes.empty() ? kNone : 0;
+        while (current != kNone)
+        {
+            uint32_t d = pattern.distanceTo(keyOf(nodes[current]));
+            if (d == 0)
+                return current;
+            uint32_t child = nodes[current].firstChild;
+            while (child != kNone && nodes[child].distance != d)
+                child = nodes[child].nextSibling;
+            current = child;
+        }
+        return kNone;
+    }
+
+    // key를 가진 레시피 copies개를 추가합니다.
+    void insertCopies(string_view key, uint32_t copies)
+    {
+        Pattern pattern(key);
+        if (nodes.empty())
+        {
+            addNode(key, 0);
+            nodes[0].count = copies;
+            liveKeys++;
+            return;
+        }
+        uint32_t current = 0;
+        while (true)
+        {
+            uint32_t d = pattern.distanceTo(keyOf(nodes[current]));
+            if (d == 0)
+            {
+                if (nodes[current].count == 0)
+                    liveKeys++;
+                nodes[current].count += copies;
+                return;
+            }
+            uint32_t child = nodes[current].firstChild;
+            while (child != kNone && nodes[child].distance != d)
+                child = nodes[child].nextSibling;
+            if (child == kNone)
+            {
+                uint32_t added = addNode(key, d); // addNode가 nodes를 늘리므로 참조를 미리 잡아 두지 않음
+                nodes[added].count = copies;
+                nodes[added].nextSibling = nodes[current].firstChild;
+                nodes[current].firstChild = added;
+                liveKeys++;
+                return;
+            }
+            current = child;
+        }
+    }
+
+    // 살아있는 키(count > 0)만 원래 추가 순서대로 다시 넣어 트리를 새로 만듭니다.
+    void rebuildLive()
+    {
+        string oldKeys;
+        vector<Node> oldNodes;
+        oldKeys.swap(keys);
+        oldNodes.swap(nodes);
+        liveKeys = 0;
+        size_t liveBytes = 0, liveCount = 0;
+        for (const Node &node : oldNodes)
+        {
+            if (node.count > 0)
+            {
+                liveBytes += node.keyLength;
+                liveCount++;
+            }
+        }
+        reserve(liveCount, liveBytes);
+        for (const Node &node : oldNodes)
+        {
+            if (node.count > 0)
+                insertCopies(string_view(oldKeys).substr(node.keyStart, node.keyLength), node.count);
+        }
+    }
+
+public:
+    void clear()
+    {
+        keys.clear();
+        nodes.clear();
+        liveKeys = 0;
+    }
+
+    // 레시피 수가 1 이상인 서로 다른 키의 수
+    size_t size() const { return liveKeys; }
+
+    void reserve(size_t expectedKeys, size_t expectedBytes)
+    {
+        nodes.reserve(expectedKeys);
+        keys.reserve(expectedBytes);
+    }
+
+    // 만든 노드 수 (레시피가 없는 빈 노드 포함)
+    size_t nodeCount() const { return nodes.size(); }
+
+    // key를 가진 레시피를 하나 추가합니다.
+    void insert(string_view key) { insertCopies(key, 1); }
+
+    // key를 가진 레시피를 하나 뺍니다. 빈 노드가 살아있는 노드보다 많아지면 트리를 다시 만듭니다.
+    void erase(string_view key)
+    {
+        uint32_t node = findNode(Pattern(key));
+        if (node == kNone || nodes[node].count == 0 || --nodes[node].count > 0)
+            return;
+        liveKeys--;
+        if (nodes.size() >= kMinRebuildNodes && nodes.size() - liveKeys > liveKeys)
+            rebuildLive();
+    }
+
+    /*
+     * void forEachWithin(string_view query, uint32_t maxDistance, Visitor visit) const:
+     * query와 편집 거리가 maxDistance 이하인 (레시피가 있는) 키마다 visit(key, distance)를 호출합니다. (순서 없음)
+     */
+    template <typename Visitor>
+    void forEachWithin(string_view query, uint32_t maxDistance, Visitor visit) const
+    {
+        if (nodes.empty())
+            return;
+        Pattern pattern(query);
+        vector<uint32_t> pending{0};
+        while (!pending.empty())
+        {
+            uint32_t current = pending.back();
+            pending.pop_back();
+            uint32_t d = pattern.distanceTo(keyOf(nodes[current]));
+            if (d <= maxDistance && nodes[current].count > 0)
+                visit(keyOf(nodes[current]), d);
+            uint32_t low = d > maxDistance ? d - maxDistance : 0;
+            uint32_t high = d + maxDistance;
+            for (uint32_t child = nodes[current].firstChild; child != kNone; child = nodes[child].nextSibling)
+            {
+                if (nodes[child].distance >= low && nodes[child].distance <= high)
+                    pending.push_back(child);
+            }
+        }
+    }
+};
+
+#endif // TITLE_BK_TREE_H
@@ -0,0 +1,132 @@
+#ifndef TITLE_HASH_TABLE_H
+#define TITLE_HASH_TABLE_H
+
+#include <cstdint>     // uint32_t, uint64_t
+#include <functional>  // std::hash<string_view>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+/**
+ * TitleHashTable 클래스
+ * --------------------------
+ * 제목 문자열 -> 레시피 id를 찾는 해시 표. (같은 제목의 레시피가 여러 개일 수 있으므로 multimap)
+ * - 문자열은 보관하지 않고 32비트 해시와 id만 한 칸(8바이트)에 저장하는 open addressing(선형 탐사) 표입니다.
+ * - 해시가 같은 다른 제목도 함께 나오므로, 호출하는 쪽이 id의 실제 제목과 한 번 더 비교해야 합니다.
+ * 문자열 주소를 기억하지 않으므로 아레나 압축으로 제목이 옮겨져도 표를 고칠 필요가 없습니다.
+ */
+class TitleHashTable
+{
+private:
+    struct Slot
+    {
+        uint32_t hash;
+        uint32_t id;
+    };
+    static constexpr uint32_t kEmpty = 0xFFFFFFFFu;     // 한 번도 쓰지 않은 칸 (탐사 종료)
+    static constexpr uint32_t kTombstone = 0xFFFFFFFEu; // 지운 칸 (탐사는 계속)
+
+    vector<Slot> slots;   // 크기는 항상 2의 거듭제곱
+    size_t occupied = 0;  // 살아있는 칸 + 지운 칸
+    size_t live = 0;      // 살아있는 칸
+
+    static uint32_t hashOf(string_view key)
+    {
+        uint64_t h = hash<string_view>()(key);
+        return static_cast<uint32_t>(h ^ (h >> 32));
+    }
+
+    void rehash(size_t capacity)
+    {
+        vector<Slot> old;
+        old.swap(slots);
+        slots.assign(capacity, Slot{0, kEmpty});
+        occupied = live = 0;
+        for (const Slot &slot : old)
+        {
+            if (slot.id < kTombstone)
+                place(slot.hash, slot.id);
+        }
+    }
+
+    void place(uint32_t h, uint32_t id)
+    {
+        size_t mask = slots.size() - 1;
+        for (size_t i = h & mask;; i = (i + 1) & mask)
+        {
+            if (slots[i].id == kEmpty || slots[i].id == kTombstone)
+            {
+                if (slots[i].id == kEmpty)
+                    occupied++;
+                live++;
+                slots[i] = Slot{h, id};
+                return;
+            }
+        }
+    }
+
+public:
+    // 항목이 expected개가 될 때까지 다시 늘리지 않도록 칸을 준비합니다.
+    void reserve(size_t expected)
+    {
+        size_t capacity = 16;
+        while (capacity * 7 < expected * 10)
+            capacity *= 2;
+        if (capacity > slots.size())
+            rehash(capacity);
+    }
+
+    void clear()
+    {
+        slots.clear();
+        occupied = live = 0;
+    }
+
+    void insert(string_view key, uint32_t id)
+    {
+        if ((occupied + 1) * 10 > slots.size() * 7) // 사용률 70% 초과 (지운 칸 포함)
+        {
+            // 지운 칸이 대부분이면 같은 크기로 다시 만들어 정리만 하고, 아니면 두 배로 늘립니다.
+            bool grow = (live + 1) * 2 > slots.size();
+            rehash(slots.empty() ? 16 : (grow ? slots.size() * 2 : slots.size()));
+        }
+        place(hashOf(key), id);
+    }
+
+    void erase(string_view key, uint32_t id)
+    {
+        if (slots.empty())
+            return;
+        uint32_t h = hashOf(key);
+        size_t mask = slots.size() - 1;
+        for (size_t i = h & mask; slots[i].id != kEmpty; i = (i + 1) & mask)
+        {
+            if (slots[i].id == id && slots[i].hash == h)
+            {
+                slots[i].id = kTombstone;
+                live--;
+                return;
+            }
+        }
+    }
+
+    /*
+     * void forEachCandidate(string_view key, Visitor visit) const: key와 해시가 같은 id마다 visit(id)를 호출합니다. (순서 없음)
+     */
+    template <typename Visitor>
+    void forEachCandidate(string_view key, Visitor visit) const
+    {
+        if (slots.empty())
+            return;
+        uint32_t h = hashOf(key);
+        size_t mask = slots.size() - 1;
+        for (size_t i = h & mask; slots[i].id != kEmpty; i = (i + 1) & mask)
+        {
+            if (slots[i].hash == h && slots[i].id != kTombstone)
+                visit(slots[i].id);
+        }
+    }
+};
+
+#endif // TITLE_HASH_TABLE_H
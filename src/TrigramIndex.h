@@ -0,0 +1,117 @@
+#ifndef TRIGRAM_INDEX_H
+#define TRIGRAM_INDEX_H
+
+#include <algorithm>     // std::upper_bound, std::binary_search, std::sort
+#include <cstdint>       // uint32_t
+#include <functional>    // std::less: 포인터 정렬
+#include <string>
+#include <string_view>
+#include <unordered_map> // 트라이그램 -> posting list
+#include <vector>
+#include "TextScan.h"    // blob 전체를 훑는 벡터 스캔
+
+using namespace std;
+
+/**
+ * TrigramIndex 클래스
+ * --------------------------
+ * id 순서대로 추가되는 (이미 소문자로 바꾼) 키 목록에서 "부분 문자열 part를 포함하는 키"를 빠르게 찾는 색인.
+ * - 키는 '\n'으로 구분해 하나의 문자열(blob)에 이어 붙여 보관합니다. (key(id)로 뷰를 얻음)
+ * - 키의 모든 연속 3바이트(트라이그램)마다 그 트라이그램을 가진 키 id 목록(오름차순)을 기록합니다.
+ *
+ * 길이 3 이상의 part를 포함하는 키는 part의 모든 트라이그램을 가지므로,
+ * 가장 짧은 목록부터 교집합해 후보를 좁힌 뒤 실제로 포함하는지 확인합니다. (결과는 모든 키에 find를 한 것과 같음)
+ * 3바이트보다 짧은 part는 트라이그램이 없으므로 blob 전체를 TextScan으로 한 번 훑습니다. (찾는 문자열에 '\n'이 없으므로 두 키에 걸쳐 일치하지 않음)
+ * 키는 추가만 되고 삭제되지 않습니다.
+ */
+class TrigramIndex
+{
+private:
+    string blob;
+    vector<uint32_t> starts{0}; // 키 id의 시작 위치 (마지막 원소는 blob 끝)
+    unordered_map<uint32_t, vector<uint32_t>> postings; // 트라이그램 -> 키 id (오름차순)
+
+    static uint32_t trigramAt(string_view text, size_t i)
+    {
+        return (static_cast<uint32_t>(static_cast<unsigned char>(text[i])) << 16) |
+               (static_cast<uint32_t>(static_cast<unsigned char>(text[i + 1])) << 8) |
+               static_cast<uint32_t>(static_cast<unsigned char>(text[i + 2]));
+    }
+
+public:
+    size_t size() const { return starts.size() - 1; }
+
+    string_view key(uint32_t id) const
+    {
+        return string_view(blob).substr(starts[id], starts[id + 1] - starts[id] - 1);
+    }
+
+    // 다음 id로 키를 추가합니다. folded에는 '\n'이 없어야 합니다.
+    void append(string_view folded)
+    {
+        uint32_t id = static_cast<uint32_t>(size());
+        for (size_t i = 0; i + 3 <= folded.size(); i++)
+        {
+            vector<uint32_t> &list = postings[trigramAt(folded, i)];
+            if (list.empty() || list.back() != id) // 같은 키 안에서 반복되는 트라이그램은 한 번만
+                list.push_back(id);
+        }
+        blob += folded;
+        blob += '\n';
+        starts.push_back(static_cast<uint32_t>(blob.size()));
+    }
+
+    void clear()
+    {
+        blob.clear();
+        starts.assign(1, 0);
+        postings.clear();
+    }
+
+    /*
+     * void forEachContaining(string_view part, Visitor visit) const: part를 포함하는 키의 id마다 visit(id)를 오름차순으로 한 번씩 호출합니다.
+     */
+    template <typename Visitor>
+    void forEachContaining(string_view part, Visitor visit) const
+    {
+        if (part.size() < 3)
+        {
+            string_view all(blob);
+            size_t pos = TextScan::findFolded(all, part);
+            while (pos < all.size())
+            {
+                uint32_t id = static_cast<uint32_t>(upper_bound(starts.begin(), starts.end(), pos) - starts.begin() - 1);
+                visit(id);
+                pos = TextScan::findFolded(all, part, starts[id + 1]);
+            }
+            return;
+        }
+
+        // part의 트라이그램별 목록을 짧은 것부터 정렬합니다. 하나라도 없으면 일치하는 키가 없습니다.
+        vector<const vector<uint32_t> *> lists;
+        for (size_t i = 0; i + 3 <= part.size(); i++)
+        {
+            auto it = postings.find(trigramAt(part, i));
+            if (it == postings.end())
+                return;
+            lists.push_back(&it->second);
+        }
+        sort(lists.begin(), lists.end(), [](const vector<uint32_t> *a, const vector<uint32_t> *b) {
+            return a->size() != b->size() ? a->size() < b->size() : less<const vector<uint32_t> *>()(a, b);
+        });
+        lists.erase(unique(lists.begin(), lists.end()), lists.end()); // part 안에서 반복되는 트라이그램
+
+        // 가장 짧은 목록의 후보 중 나머지 목록에도 모두 있는 것만 남긴 뒤, 실제 포함 여부를 확인합니다.
+        // (트라이그램이 모두 있어도 순서/위치가 달라 part를 포함하지 않을 수 있음)
+        for (uint32_t id : *lists[0])
+        {
+            bool inAll = true;
+            for (size_t k = 1; inAll && k < lists.size(); k++)
+                inAll = binary_search(lists[k]->begin(), lists[k]->end(), id);
+            if (inAll && key(id).find(part) != string_view::npos)
+                visit(id);
+        }
+    }
+};
+
+#endif // TRIGRAM_INDEX_H
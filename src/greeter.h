@@ -5,6 +5,7 @@
 #include <limits>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <stdlib.h>
 #include <algorithm>
 #include <random>
@@ -13,6 +14,7 @@
 #include "PlanManager.h"
 #include "Date.h"
 #include "Meal.h"
+#include "MappedFile.h" // 일정 파일을 복사 없이 읽기 위해 포함
 
 using namespace std;
 
@@ -51,7 +53,9 @@ private:
         std::cout << "8. Schedule Management\n";
         std::cout << "9. Meal Management\n";
         std::cout << "10. Plan Manager\n";
-        std::cout << "11. Save and Exit\n";
+        std::cout << "11. Data Tools\n";
+        std::cout << "12. Cook from My Pantry\n";
+        std::cout << "13. Save and Exit\n";
         std::cout << "==========================\n";
         std::cout << "> ";
     }
@@ -76,6 +80,11 @@ private:
         db.editRecipe(); // 데이터베이스 객체에게 수정을 요청
     }
 
+    void handlePantry()
+    {
+        db.cookFromPantry(); // 데이터베이스 객체에게 가진 재료로 만들 수 있는 레시피 검색을 요청
+    }
+
     void handleSort()
     {
         db.sortRecipe(); // 데이터베이스 객체에게 정렬을 요청
@@ -95,10 +104,9 @@ public:
         // 현재 날짜 Date 객체 생성
         Date startDate(1900 + ltm->tm_year, 1 + ltm->tm_mon, ltm->tm_mday, 0, 0, "Plan Start");
 
-        // 1주일 후 날짜 계산
-        time_t oneWeekLater = now + (7 * 24 * 60 * 60); // 7일 * 24시간 * 60분 * 60초
-        tm *endTm = localtime(&oneWeekLater);
-        Date endDate(1900 + endTm->tm_year, 1 + endTm->tm_mon, endTm->tm_mday, 23, 59, "Plan End");
+        // 1주일 후 날짜 계산 (날짜 번호에 7을 더함)
+        Date endDate(startDate.getYear(), startDate.getMonth(), startDate.getDay(), 23, 59, "Plan End");
+        endDate.addDays(7);
 
         // PlanManager 생성 (시작날짜, 종료날짜 전달)
         planManager = new PlanManager(startDate, endDate);
@@ -151,8 +159,32 @@ public:
                 planManagerMenu(); // Plan Manager 추가
                 break;
             case 11:
+                dataToolsMenu();
+                break;
+            case 12:
+                handlePantry();
+                break;
+            case 13:
                 std::cout << "Saving and exiting..." << std::endl;
-                db.saveToFile();
+                // 저널을 쓰는 중이면 변경 내용은 이미 디스크에 있음 (저널이 커졌을 때만 합침)
+                if (!db.save())
+                {
+                    // 저장하지 못한 변경을 버리지 않도록 종료하지 않고 메뉴로 돌아감
+                    std::cout << "Save failed. Your changes are not on disk yet; fix the problem and try again." << std::endl;
+                    break;
+                }
+                if (db.getJournalBytes() == 0)
+                {
+                    // 스냅샷을 쓰고 있었고 기본 파일이 바뀌었다면 저장한 내용으로 함께 갱신 (다음 시작 시 바로 사용 가능)
+                    std::string snapshotPath = RecipeDatabase::defaultSnapshotPath(db.getFilename());
+                    std::ifstream existing(snapshotPath);
+                    if (existing.good())
+                    {
+                        existing.close();
+                        if (!RecipeDatabase::isSnapshotFresh(snapshotPath, db.getFilename()) && !db.saveSnapshot(snapshotPath))
+                            std::cout << "Snapshot " << snapshotPath << " could not be refreshed; it will be ignored next time." << std::endl;
+                    }
+                }
                 std::cout << "Data saved successfully. Goodbye!" << std::endl;
                 return;
             default:
@@ -187,8 +219,8 @@ public:
             return;
         }
 
-        // RecipeDatabase에서 해당 난이도의 레시피들 가져오기
-        std::vector<std::string> availableRecipes = getRecipesByDifficultyLevel(difficultyChoice);
+        // RecipeDatabase에서 해당 난이도의 레시피들 가져오기 (행 번호 뷰, 복사 없음)
+        DifficultyRows availableRecipes = getRowsByDifficultyLevel(difficultyChoice);
 
         std::string difficultyLevel;
         switch (difficultyChoice)
@@ -214,24 +246,31 @@ public:
         }
 
         // 랜덤하게 최대 5개 추천
+        // 전체 목록을 섞지 않고, 서로 다른 위치 5개만 뽑아 그 레시피의 제목만 복사합니다.
+        const std::vector<Recipe> &recipes = db.getRecipes();
         std::vector<std::string> recommendedRecipes;
 
         if (availableRecipes.size() <= 5)
         {
-            // 5개 이하면 모든 레시피 추천
-            recommendedRecipes = availableRecipes;
+            // 5개 이하면 모든 레시피를 목록 순서로 추천
+            for (uint32_t row : availableRecipes.sortedRows())
+                recommendedRecipes.emplace_back(recipes[row].getTitle());
         }
         else
         {
             // 5개 초과면 랜덤하게 5개 선택
-            std::vector<std::string> temp = availableRecipes;
             std::random_device rd;
             std::mt19937 g(rd());
-            std::shuffle(temp.begin(), temp.end(), g);
-
-            for (int i = 0; i < 5; i++)
+            std::uniform_int_distribution<size_t> pick(0, availableRecipes.size() - 1);
+            std::vector<size_t> chosen;
+            while (chosen.size() < 5)
             {
-                recommendedRecipes.push_back(temp[i]);
+                size_t i = pick(g);
+                if (std::find(chosen.begin(), chosen.end(), i) == chosen.end())
+                {
+                    chosen.push_back(i);
+                    recommendedRecipes.emplace_back(recipes[availableRecipes[i]].getTitle());
+                }
             }
         }
 
@@ -247,10 +286,10 @@ public:
 
 private:
     // RecipeDatabase에서 난이도별 레시피 검색 (private helper 함수)
-    std::vector<std::string> getRecipesByDifficultyLevel(char maxLevel)
+    DifficultyRows getRowsByDifficultyLevel(char maxLevel)
     {
-        // RecipeDatabase에서 실제 레시피를 검색
-        return db.getRecipesByDifficultyLevel(maxLevel);
+        // RecipeDatabase가 유지하는 난이도별 목록의 뷰
+        return db.getRowsUpToDifficulty(maxLevel);
     }
 
     // 일정 확인 함수
@@ -277,8 +316,16 @@ private:
         std::cout << "Enter new schedule (e.g., 2024-10-02 14:00 - Meeting with team - Recipe_name): ";
         std::getline(std::cin, scheduleInput);
 
-        // Date 객체 생성
-        Date newSchedule(scheduleInput);
+        // Date 객체 생성 (형식이 틀리면 틀린 위치를 보여주고 추가하지 않음)
+        Date newSchedule;
+        DateParseError error;
+        if (!Date::tryParse(scheduleInput, newSchedule, &error))
+        {
+            std::cout << "❌ Invalid schedule at column " << error.position + 1 << ": " << error.reason << std::endl;
+            std::cout << "   " << scheduleInput << std::endl;
+            std::cout << "   " << std::string(error.position, ' ') << "^" << std::endl;
+            return;
+        }
         schedules.push_back(newSchedule);
 
         std::cout << "Schedule added successfully!" << std::endl;
@@ -288,6 +335,63 @@ private:
         std::cout << "Added: " << newSchedule.toString() << std::endl;
     }
 
+    /*
+     * void importSchedules(): 한 줄에 일정 하나("YYYY-MM-DD HH:MM - 설명 - 레시피")인 파일을 읽어 일정 목록에 추가합니다.
+     * details: 파일을 메모리에 매핑해 줄마다 Date::tryParse로 읽습니다. 빈 줄과 '#'로 시작하는 줄은 건너뜁니다.
+     *          형식이 틀린 줄은 추가하지 않고 "줄:칸: 이유"로 알려 줍니다. (처음 kMaxReportedErrors개만 출력)
+     */
+    void importSchedules()
+    {
+        static const size_t kMaxReportedErrors = 10;
+        std::string path;
+        std::cout << "Enter schedule file path: ";
+        std::getline(std::cin, path);
+
+        MappedFile file;
+        if (!file.open(path))
+        {
+            std::cout << "❌ Could not open '" << path << "'." << std::endl;
+            return;
+        }
+        std::string_view text = file.view();
+        schedules.reserve(schedules.size() + static_cast<size_t>(std::count(text.begin(), text.end(), '\n')) + 1);
+
+        size_t imported = 0, failed = 0, lineNumber = 0;
+        Date schedule;
+        DateParseError error;
+        for (size_t pos = 0; pos < text.size();)
+        {
+            size_t end = text.find('\n', pos);
+            if (end == std::string_view::npos)
+                end = text.size();
+            std::string_view line = text.substr(pos, end - pos);
+            pos = end + 1;
+            lineNumber++;
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+            size_t first = line.find_first_not_of(" \t");
+            if (first == std::string_view::npos || line[first] == '#')
+                continue;
+
+            if (Date::tryParse(line, schedule, &error))
+            {
+                schedules.push_back(schedule);
+                imported++;
+            }
+            else if (++failed <= kMaxReportedErrors)
+            {
+                std::cout << "   line " << lineNumber << ":" << error.position + 1 << ": " << error.reason << std::endl;
+            }
+        }
+        if (failed > kMaxReportedErrors)
+            std::cout << "   ... and " << (failed - kMaxReportedErrors) << " more invalid lines" << std::endl;
+
+        std::cout << "Imported " << imported << " schedule(s)";
+        if (failed > 0)
+            std::cout << ", skipped " << failed << " invalid line(s)";
+        std::cout << ". Total schedules: " << schedules.size() << std::endl;
+    }
+
 public:
     // 일정 관리 메뉴 함수
     void scheduleMenu()
@@ -299,7 +403,8 @@ public:
             std::cout << "\n===== Schedule Management =====" << std::endl;
             std::cout << "1. View Schedules" << std::endl;
             std::cout << "2. Add Schedule" << std::endl;
-            std::cout << "3. Back to Main Menu" << std::endl;
+            std::cout << "3. Import Schedules from File" << std::endl;
+            std::cout << "4. Back to Main Menu" << std::endl;
             std::cout << "Please select: ";
 
             std::cin >> choice;
@@ -314,6 +419,9 @@ public:
                 addSchedule();
                 break;
             case 3:
+                importSchedules();
+                break;
+            case 4:
                 std::cout << "Returning to main menu..." << std::endl;
                 return;
             default:
@@ -471,6 +579,73 @@ public:
         }
     }
 
+    // 데이터 도구 메뉴 함수 (텍스트 <-> 바이너리 스냅샷 변환 및 검사, 변경 저널 합치기, 문자열 아레나 압축)
+    void dataToolsMenu()
+    {
+        int choice;
+
+        while (true)
+        {
+            std::string textPath = db.getFilename();
+            std::string snapshotPath = RecipeDatabase::defaultSnapshotPath(textPath);
+
+            std::cout << "\n===== Data Tools =====" << std::endl;
+            std::cout << "1. Convert Recipe Text -> Binary Snapshot (" << textPath << " -> " << snapshotPath << ")" << std::endl;
+            std::cout << "2. Convert Binary Snapshot -> Recipe Text" << std::endl;
+            std::cout << "3. Verify Snapshot against Recipe Text" << std::endl;
+            std::cout << "4. Compact Change Journal into " << textPath << " (" << db.getJournalBytes() << " bytes pending)" << std::endl;
+            std::cout << "5. Show Text Arena Usage and Compact" << std::endl;
+            std::cout << "6. Back to Main Menu" << std::endl;
+            std::cout << "Select: ";
+
+            std::cin >> choice;
+            std::cin.ignore();
+
+            if (choice == 1)
+            {
+                RecipeDatabase::convertTextToSnapshot(textPath, snapshotPath);
+            }
+            else if (choice == 2)
+            {
+                std::string outPath;
+                std::cout << "Enter output text file name: ";
+                getline(std::cin, outPath);
+                if (outPath.empty())
+                {
+                    std::cout << "No file name given." << std::endl;
+                }
+                else
+                {
+                    RecipeDatabase::convertSnapshotToText(snapshotPath, outPath);
+                }
+            }
+            else if (choice == 3)
+            {
+                RecipeDatabase::verifySnapshot(snapshotPath, textPath);
+            }
+            else if (choice == 4)
+            {
+                db.compactJournal();
+            }
+            else if (choice == 5)
+            {
+                db.printArenaStats();
+                db.compactArena();
+                std::cout << "After compaction: ";
+                db.printArenaStats();
+            }
+            else if (choice == 6)
+            {
+                std::cout << "Returning to main menu..." << std::endl;
+                break;
+            }
+            else
+            {
+                std::cout << "Invalid choice." << std::endl;
+            }
+        }
+    }
+
     // 소멸자
     ~Greeter()
     {
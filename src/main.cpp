@@ -6,10 +6,18 @@ int main()
 {
     // 1. 데이터베이스 객체를 먼저 생성
     RecipeDatabase db;
+    db.setLazyProcedures(true); // 조리 절차는 화면에 보여줄 때만 파일에서 읽음
+    db.setJournaling(true);     // 변경 내용은 Recipe.journal에 덧붙이고, 로딩 시 다시 적용
 
     // 2. 파일에서 데이터를 불러와서 db를 채움
+    //    최신 바이너리 스냅샷(Recipe.snap)이 있으면 텍스트 파싱 없이 바로 읽음
     string filename = "Recipe.txt";
-    if (db.loadFromFile(filename))
+    string snapshot = RecipeDatabase::defaultSnapshotPath(filename);
+    if (RecipeDatabase::isSnapshotFresh(snapshot, filename) && db.loadFromSnapshot(snapshot, filename))
+    {
+        cout << "Successfully loaded recipes from snapshot " << snapshot << endl;
+    }
+    else if (db.loadFromFileParallel(filename))
     {
         cout << "Successfully loaded recipes from " << filename << endl;
     }